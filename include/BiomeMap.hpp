@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include "Chunk.hpp"
+#include "PerlinNoise.hpp"
+
+enum class Biome {
+    Plains,
+    Forest,
+    Desert,
+    Ocean
+};
+
+struct TerrainColumn {
+    Biome biome;
+    int surfaceHeight;
+    float temperature;
+    float moisture;
+};
+
+// Climate and surface height for every terrain column. Low-frequency
+// temperature and moisture noise is evaluated once per region on a coarse
+// grid and interpolated, and the resulting columns are cached so chunks
+// stacked in the same column never re-evaluate any noise.
+class BiomeMap {
+public:
+    BiomeMap();
+    const TerrainColumn& getColumn(int worldX);
+    // Never inserts, so it is safe from several threads at once. Throws
+    // std::out_of_range if the region has not been created by getColumn.
+    const TerrainColumn& getCachedColumn(int worldX) const;
+    // Drop cached regions not in the sorted list, they regenerate identically on use
+    void retainRegions(const std::vector<int>& used);
+    static int getRegionIndex(int worldX);
+
+    static constexpr int REGION_CHUNKS = 16;
+    static constexpr int REGION_SIZE = REGION_CHUNKS * Chunk::SIZE; // Columns per region
+    static constexpr int GRID_SPACING = Chunk::SIZE; // Columns between climate samples
+
+private:
+    struct Region {
+        std::array<TerrainColumn, REGION_SIZE> columns;
+    };
+
+    const Region& getRegion(int regionX);
+    void generateRegion(Region& region, int regionX);
+    int computeSurfaceHeight(int worldX, float temperature, float moisture);
+    static Biome classify(float temperature, float moisture);
+
+    PerlinNoise heightNoise;
+    PerlinNoise temperatureNoise;
+    PerlinNoise moistureNoise;
+    // Region nodes are recycled as explorers move on instead of going back
+    // to the system allocator
+    std::pmr::unsynchronized_pool_resource regionNodes;
+    std::pmr::unordered_map<int, Region> regions;
+
+    static constexpr double TERRAIN_SCALE = 0.05;
+    static constexpr double CLIMATE_SCALE = 0.004;
+};
@@ -12,13 +12,14 @@ enum class BlockType {
     Diamond,
     Water,
     WoodLog,
-    Leaves
+    Leaves,
+    Sand
 };
 
 class Block {
 public:
     Block(BlockType type = BlockType::Air);
-    void render(sf::RenderTarget& target, float x, float y);
+    void render(sf::RenderTarget& target, float x, float y) const;
     bool isSolid() const;
     bool isLiquid() const;
     BlockType getType() const;
@@ -26,13 +27,17 @@ public:
     static constexpr float SIZE = 32.0f; // Size of each block in pixels
     static void loadTextures();
     static void loadTexture(BlockType type, const std::string& filepath);
+    // Mean color of the type's texture, e.g. for tinting effects
+    static sf::Color getAverageColor(BlockType type);
 
 private:
+    // Blocks only store their type so chunks can hold them in flat,
+    // allocation-free arrays. The drawable shape is shared per type.
     BlockType type;
-    sf::RectangleShape shape;
 
-    void initializeVisuals();
-    sf::Color getColorForType() const;
+    static sf::RectangleShape& getShape(BlockType type);
 
     static std::map<BlockType, sf::Texture> textures;
-};
\ No newline at end of file
+    static std::map<BlockType, sf::RectangleShape> shapes;
+    static std::map<BlockType, sf::Color> averageColors;
+};
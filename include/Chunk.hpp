@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Block.hpp"
+
+struct Chunk {
+    static constexpr int SIZE = 16;
+    std::array<std::array<Block, SIZE>, SIZE> blocks;
+    bool isGenerated;
+    bool isModified; // Edited by the player, must not be evicted
+    bool isDirty;    // Changed since it was last handed to the renderer
+    std::uint64_t revision; // Bumped by the world whenever the contents change
+
+    Chunk() : isGenerated(false), isModified(false), isDirty(false), revision(0) {}
+
+    // Return the chunk to its freshly constructed state for reuse
+    void reset() {
+        for (auto& column : blocks) {
+            column.fill(Block(BlockType::Air));
+        }
+        isGenerated = false;
+        isModified = false;
+        isDirty = false;
+        revision = 0;
+    }
+};
+
+// Integer division rounding towards negative infinity, e.g. block to chunk coordinates
+inline int floorDiv(int value, int divisor) {
+    int quotient = value / divisor;
+    if ((value % divisor != 0) && ((value < 0) != (divisor < 0))) {
+        --quotient;
+    }
+    return quotient;
+}
+
+// Pack chunk coordinates into a single hash map key
+inline std::int64_t chunkKey(int chunkX, int chunkY) {
+    // Shift as unsigned, left-shifting a negative value is undefined
+    return static_cast<std::int64_t>((static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX)) << 32) |
+                                     static_cast<std::uint32_t>(chunkY));
+}
+
+inline int chunkKeyX(std::int64_t key) {
+    return static_cast<int>(key >> 32);
+}
+
+inline int chunkKeyY(std::int64_t key) {
+    return static_cast<int>(static_cast<std::int32_t>(key & 0xFFFFFFFF));
+}
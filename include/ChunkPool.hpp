@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Chunk.hpp"
+
+// Hands out chunk storage from fixed-size slabs. Released chunks go back on
+// a free list and are reused before a new slab is requested from the system.
+class ChunkPool {
+public:
+    explicit ChunkPool(std::size_t chunksPerSlab = 64);
+    Chunk* acquire();
+    void release(Chunk* chunk);
+
+    std::size_t getCapacity() const;
+    std::size_t getInUse() const;
+    std::size_t getSlabCount() const;
+    float getOccupancy() const;
+
+private:
+    void addSlab();
+
+    std::size_t chunksPerSlab;
+    std::vector<std::unique_ptr<Chunk[]>> slabs;
+    std::vector<Chunk*> freeList;
+    std::size_t inUse;
+};
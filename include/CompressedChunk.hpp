@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include "Chunk.hpp"
+
+// Palette-compressed, bit-packed copy of a chunk for the cold tier. A chunk
+// made of a single block type keeps just that type. Otherwise the palette and
+// the packed words, sized by the bits each entry needs, share one buffer from
+// the given resource, so compressing and evicting chunks recycles pooled
+// memory instead of going to the heap.
+class CompressedChunk {
+public:
+    CompressedChunk();
+    explicit CompressedChunk(const Chunk& chunk,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    CompressedChunk(CompressedChunk&& other) noexcept;
+    CompressedChunk& operator=(CompressedChunk&& other) noexcept;
+    CompressedChunk(const CompressedChunk&) = delete;
+    CompressedChunk& operator=(const CompressedChunk&) = delete;
+    ~CompressedChunk();
+
+    void decompress(Chunk& chunk) const;
+    BlockType get(int x, int y) const;
+    bool isUniform() const;
+    bool isModified() const;
+    std::size_t getMemoryUsage() const;
+
+private:
+    static constexpr int ENTRY_COUNT = Chunk::SIZE * Chunk::SIZE;
+    static constexpr int MAX_PALETTE_SIZE = 16; // Every block type fits in 4 bits
+    static constexpr int PALETTE_WORDS = MAX_PALETTE_SIZE / 8; // One byte per palette entry
+    static_assert(static_cast<int>(BlockType::Sand) < MAX_PALETTE_SIZE, "Every block type must fit in the palette");
+
+    void release();
+
+    std::pmr::memory_resource* resource;
+    std::uint64_t* words; // Palette bytes, then packed palette indices. Null when uniform.
+    std::uint16_t wordCount;
+    BlockType uniformType;
+    std::uint8_t bitsPerEntry;
+    bool modified;
+};
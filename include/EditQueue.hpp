@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include "Block.hpp"
+
+struct BlockEdit {
+    int x;
+    int y;
+    BlockType type;
+};
+
+// Single-producer single-consumer ring buffer that hands block edits from
+// the event loop to the simulation thread without locking
+class EditQueue {
+public:
+    EditQueue() : head(0), tail(0) {}
+
+    // Returns false if the queue is full and the edit was dropped
+    bool push(const BlockEdit& edit) {
+        std::size_t currentTail = tail.load(std::memory_order_relaxed);
+        std::size_t nextTail = (currentTail + 1) % CAPACITY;
+        if (nextTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        edits[currentTail] = edit;
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(BlockEdit& edit) {
+        std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        edit = edits[currentHead];
+        head.store((currentHead + 1) % CAPACITY, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr std::size_t CAPACITY = 256;
+
+    std::array<BlockEdit, CAPACITY> edits;
+    std::atomic<std::size_t> head;
+    std::atomic<std::size_t> tail;
+};
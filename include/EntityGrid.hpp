@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Block.hpp"
+#include "Chunk.hpp"
+
+// Broadphase for entity-entity queries on a uniform grid with one cell per
+// chunk. It is rebuilt from the entities' bounds every tick, so inserting,
+// querying and pairing all cost time linear in the entities involved
+// instead of testing every entity against every other.
+class EntityGrid {
+public:
+    using EntityId = std::uint32_t;
+
+    // Forget every entity but keep the occupied cells for the next rebuild
+    void clear();
+    void insert(EntityId id, const sf::FloatRect& bounds);
+
+    // Entities whose bounds overlap the area or circle, each reported once
+    void queryArea(const sf::FloatRect& area, std::vector<EntityId>& result) const;
+    void queryRadius(const sf::Vector2f& center, float radius, std::vector<EntityId>& result) const;
+    // Every pair of entities whose bounds overlap, each reported once
+    void findOverlappingPairs(std::vector<std::pair<EntityId, EntityId>>& pairs) const;
+
+    std::size_t getEntityCount() const;
+
+    static constexpr float CELL_SIZE = Chunk::SIZE * Block::SIZE;
+
+private:
+    struct Entry {
+        EntityId id;
+        sf::FloatRect bounds;
+        int minCellX, minCellY, maxCellX, maxCellY;
+    };
+
+    std::vector<Entry> entries;
+    std::unordered_map<std::int64_t, std::vector<std::uint32_t>> cells; // Entry indices per cell
+
+    static int cellCoord(float position);
+    static bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b);
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "Chunk.hpp"
+
+// Block contents of one chunk as seen by the renderer, or its removal
+struct ChunkUpdate {
+    std::uint64_t frame; // Simulation frame that produced this update
+    sf::Vector2i position;
+    bool removed;
+    std::array<BlockType, Chunk::SIZE * Chunk::SIZE> blocks;
+};
+
+// Everything the render thread needs to draw one frame. Chunk updates are
+// cumulative until the renderer has acknowledged them, so a dropped frame
+// never loses an edit.
+struct FrameSnapshot {
+    std::uint64_t frame = 0;
+    sf::Vector2f playerPosition;
+    sf::Vector2f cameraTarget;
+    std::vector<ChunkUpdate> chunkUpdates;
+};
+
+// Lock-free triple buffer between the simulation thread (writer) and the
+// render thread (reader). Neither side ever waits for the other.
+class SnapshotBuffer {
+public:
+    SnapshotBuffer() : middle(1), back(0), front(2), consumedFrame(0) {}
+
+    // Simulation thread: the buffer to fill for the next publish
+    FrameSnapshot& getBack() {
+        return buffers[back];
+    }
+
+    // Simulation thread: make the back buffer the newest snapshot
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Render thread: the newest published snapshot
+    const FrameSnapshot& acquireLatest() {
+        if (middle.load(std::memory_order_relaxed) & FRESH) {
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+            consumedFrame.store(buffers[front].frame, std::memory_order_release);
+        }
+        return buffers[front];
+    }
+
+    // Newest frame the renderer has picked up
+    std::uint64_t getConsumedFrame() const {
+        return consumedFrame.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr int FRESH = 4;
+    static constexpr int INDEX_MASK = 3;
+
+    std::array<FrameSnapshot, 3> buffers;
+    std::atomic<int> middle;
+    int back;
+    int front;
+    std::atomic<std::uint64_t> consumedFrame;
+};
@@ -1,28 +1,65 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
 #include "World.hpp"
 #include "Player.hpp"
 #include "Camera.hpp"
 #include "Inventory.hpp"
+#include "EditQueue.hpp"
+#include "MetricsExporter.hpp"
+#include "NavigationGrid.hpp"
+#include "ParticleSystem.hpp"
+#include "Pathfinder.hpp"
+#include "FrameSnapshot.hpp"
+#include "UILayer.hpp"
+#include "WorldRenderer.hpp"
 
+// The window, events and rendering stay on the main thread. World and player
+// simulation run on their own thread and hand each tick over as a snapshot.
 class Game {
 public:
     Game();
+    ~Game();
     void run();
 
 private:
     void processEvents();
+    void simulate();
     void update(float deltaTime);
-    void render();
+    void publishSnapshot();
+    void render(const FrameSnapshot& snapshot, float deltaTime);
 
     sf::RenderWindow window;
     std::unique_ptr<World> world;
     std::unique_ptr<Player> player;
     std::unique_ptr<Camera> camera;
     std::unique_ptr<Inventory> inventory;
+    std::unique_ptr<NavigationGrid> navigation;
+    std::unique_ptr<Pathfinder> pathfinder; // For actors to request paths from the tick
+    std::unique_ptr<WorldRenderer> worldRenderer;
+    std::unique_ptr<ParticleSystem> particles;
+    UILayer ui;
+    std::unique_ptr<MetricsExporter> metricsExporter;
+
+    // Simulation thread state
+    std::thread simulationThread;
+    std::atomic<bool> running;
+    std::uint64_t simulationFrame;
+    std::vector<ChunkUpdate> pendingUpdates; // Not yet acknowledged by the renderer
+    std::vector<sf::Vector2i> changedChunks;
+    std::vector<sf::Vector2i> removedChunks;
+
+    // Hand-over between the threads
+    EditQueue edits;
+    std::atomic<std::uint8_t> playerInput; // Latest keyboard state packed into bits, read on the main thread
+    SnapshotBuffer snapshots;
+    std::uint64_t renderedFrame;
     
     static constexpr int WINDOW_WIDTH = 1280;
     static constexpr int WINDOW_HEIGHT = 720;
     static constexpr char WINDOW_TITLE[] = "Blockworld";
-};
\ No newline at end of file
+    static constexpr float TICK_DURATION = 1.0f / 60.0f;
+};
@@ -2,6 +2,7 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include "Block.hpp"
+#include "Widget.hpp"
 
 struct InventorySlot {
     BlockType blockType;
@@ -10,23 +11,30 @@ struct InventorySlot {
     InventorySlot() : blockType(BlockType::Air), quantity(0) {}
 };
 
-class Inventory {
+// Hotbar, redrawn into its cached texture only when slots or the selection change
+class Inventory : public Widget {
 public:
     Inventory();
-    void render(sf::RenderTarget& target);
+    bool handleEvent(const sf::Event& event) override;
     void addItem(BlockType type, int count = 1);
     bool removeItem(BlockType type, int count = 1);
     void selectSlot(int slot);
     BlockType getSelectedType() const;
-    void handleInput();
+
+    // Place the hotbar at the bottom center of a screen of the given size
+    void layout(const sf::Vector2f& screenSize);
+
+protected:
+    void redraw(sf::RenderTarget& canvas) override;
 
 private:
     static constexpr int SLOT_COUNT = 9;
     static constexpr float SLOT_SIZE = 50.0f;
     static constexpr float SLOT_PADDING = 5.0f;
+    static constexpr float MARGIN = 2.0f; // Room for the selected slot outline
     
-    std::vector<InventorySlot> slots;
     int selectedSlot;
+    std::vector<InventorySlot> slots;
     sf::RectangleShape slotShape;
     sf::RectangleShape selectedSlotShape;
-};
\ No newline at end of file
+};
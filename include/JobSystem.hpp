@@ -0,0 +1,125 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Process-wide work-stealing scheduler shared by every subsystem that runs
+// background work, so they never oversubscribe the cores between them.
+// Each worker owns a queue per priority: it pops its own work from the back
+// and steals from the front of others' when it runs dry. High priority work
+// (anything the player can see) is always taken before normal work.
+class JobSystem {
+public:
+    enum class Priority {
+        High,
+        Normal
+    };
+
+    struct Job;
+    using JobHandle = std::shared_ptr<Job>;
+
+    static JobSystem& instance();
+
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    // The job starts once every dependency has finished
+    JobHandle submit(std::function<void()> work, Priority priority = Priority::Normal,
+                     const std::vector<JobHandle>& dependencies = {});
+    // Runs other jobs on the calling thread until the job has finished. Only
+    // jobs at the job's priority or above are picked up, so waiting on
+    // visible-chunk work never gets stuck behind a long background job.
+    // Rethrows anything the job's work threw.
+    void wait(const JobHandle& job);
+    static bool isDone(const JobHandle& job);
+
+    // Split [0, count) into ranges of grainSize and run body over them in
+    // parallel. The calling thread helps and returns when all are done.
+    void parallelFor(std::size_t count, std::size_t grainSize,
+                     const std::function<void(std::size_t begin, std::size_t end)>& body,
+                     Priority priority = Priority::High);
+
+    // Queue a callback for the simulation thread, which owns the game state,
+    // optionally after some jobs have finished. Game drains the queue with
+    // processSimulationCallbacks() at the start of every tick.
+    void runOnSimulationThread(std::function<void()> callback, const std::vector<JobHandle>& after = {});
+    void processSimulationCallbacks();
+
+    unsigned getWorkerCount() const;
+    // Jobs waiting in the queues, for the metrics sampled each tick
+    std::size_t getQueuedCount() const;
+
+private:
+    static constexpr int PRIORITY_COUNT = 2;
+
+    // Double-ended ring that only allocates when it grows, so a steady job
+    // flow never touches the heap
+    class JobQueue {
+    public:
+        bool empty() const { return size == 0; }
+        void pushBack(JobHandle job);
+        JobHandle popBack();
+        JobHandle popFront();
+
+    private:
+        std::vector<JobHandle> slots;
+        std::size_t head = 0;
+        std::size_t size = 0;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::array<JobQueue, PRIORITY_COUNT> queues;
+        std::thread thread;
+    };
+
+    // Shared by the runners of one parallelFor, lives on the caller's stack
+    struct ForState {
+        const std::function<void(std::size_t, std::size_t)>* body;
+        std::size_t count;
+        std::size_t grainSize;
+        std::atomic<std::size_t> next;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+    static constexpr std::size_t MAX_RUNNERS = 64;
+
+    static void runRanges(ForState& state);
+    void workerLoop(int index);
+    bool runOne(Priority lowest = Priority::Normal);
+    JobHandle take(int self, Priority lowest);
+    void schedule(const JobHandle& job);
+    void execute(const JobHandle& job);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> nextWorker;
+    std::atomic<std::int64_t> queued;
+    std::atomic<bool> stopping;
+    std::atomic<int> sleepers; // Workers blocked on wakeup, schedule() only notifies when there are any
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+
+    std::mutex runnerMutex;
+    std::vector<JobHandle> spareRunners; // Finished parallelFor runners, ready for reuse
+
+    std::mutex callbackMutex;
+    std::vector<std::function<void()>> callbacks;
+    std::vector<std::function<void()>> runningCallbacks;
+};
+
+struct JobSystem::Job {
+    std::function<void()> work;
+    Priority priority = Priority::Normal;
+    std::atomic<int> unfinishedDependencies{0};
+    std::atomic<bool> done{false};
+    std::exception_ptr error; // Set before done, rethrown by wait()
+    std::mutex mutex; // Guards dependents and the transition to done
+    std::vector<JobHandle> dependents;
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Runtime metrics for long-running instances. Counters and histograms keep a
+// shard per thread that readers sum, so the hot paths in World, Game and the
+// job workers can record freely from any thread. Gauges are set from one
+// place at a time and stay a single relaxed atomic on a cache line of its own.
+
+constexpr std::size_t METRIC_SHARDS = 32; // Threads beyond this share shards
+
+class Counter {
+public:
+    Counter();
+    void increment(std::uint64_t amount = 1);
+    std::uint64_t get() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    std::unique_ptr<Shard[]> shards;
+};
+
+class alignas(64) Gauge {
+public:
+    Gauge() : value(0) {}
+    void set(std::int64_t newValue) {
+        value.store(newValue, std::memory_order_relaxed);
+    }
+    void add(std::int64_t amount) {
+        value.fetch_add(amount, std::memory_order_relaxed);
+    }
+    std::int64_t get() const {
+        return value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::int64_t> value;
+};
+
+// Fixed-bucket histogram, bucket bounds are inclusive upper limits. Each
+// thread records into its own shard and readers sum the shards.
+class Histogram {
+public:
+    explicit Histogram(std::vector<double> bounds);
+    void observe(double value);
+
+    const std::vector<double>& getBounds() const;
+    std::uint64_t getBucketCount(std::size_t bucket) const; // Not cumulative
+    std::uint64_t getCount() const;
+    double getSum() const;
+
+    static constexpr std::size_t MAX_BUCKETS = 24; // Including +Inf
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<double> sum{0.0};
+        std::atomic<std::uint64_t> buckets[MAX_BUCKETS] = {}; // One extra for +Inf
+    };
+
+    std::vector<double> bounds;
+    std::unique_ptr<Shard[]> shards;
+};
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    // Registered metrics live as long as the process, callers keep the reference
+    Counter& addCounter(const std::string& name, const std::string& help);
+    Gauge& addGauge(const std::string& name, const std::string& help);
+    Histogram& addHistogram(const std::string& name, const std::string& help,
+                            std::vector<double> bounds);
+
+    // Prometheus text exposition format
+    std::string exportText() const;
+    // Write atomically so a textfile collector never reads a partial file
+    bool writeTextfile(const std::string& path) const;
+
+    // Default latency buckets in seconds, 100us to 1s
+    static std::vector<double> latencyBuckets();
+
+private:
+    MetricsRegistry() = default;
+
+    enum class Kind { Counter, Gauge, Histogram };
+    struct Entry {
+        std::string name;
+        std::string help;
+        Kind kind;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    mutable std::mutex mutex; // Guards registration and export, never updates
+    std::vector<Entry> entries;
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <thread>
+
+// Periodically writes the metrics registry to a Prometheus textfile on a
+// background thread, for node_exporter's textfile collector to pick up
+class MetricsExporter {
+public:
+    MetricsExporter(const std::string& path, float intervalSeconds = 10.0f);
+    ~MetricsExporter();
+
+private:
+    void run();
+
+    std::string path;
+    float intervalSeconds;
+    std::atomic<bool> running;
+    std::thread thread;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Block.hpp"
+#include "Chunk.hpp"
+#include "Player.hpp"
+
+class World;
+
+// Walkability of one chunk for an actor the size of the player. Built on the
+// simulation thread and never modified afterwards, so path searches on worker
+// threads can read it freely.
+struct NavChunk {
+    sf::Vector2i position;
+    std::uint64_t revision = 0;      // Revisions of the chunk and its vertical
+    std::uint64_t revisionAbove = 0; // neighbours this was built from, 0 if
+    std::uint64_t revisionBelow = 0; // the neighbour was not loaded
+    std::array<std::uint16_t, Chunk::SIZE> passable{};  // Bit y of column x set if not solid
+    std::array<std::uint16_t, Chunk::SIZE> standable{}; // Bit y set if an actor can stand there
+    std::uint16_t exits = 0; // Bit (dy + 1) * 3 + (dx + 1) set if a move leads into that neighbour chunk
+};
+
+// Immutable navigation view of the loaded world at one point in time
+class NavSnapshot {
+public:
+    const NavChunk* getChunk(int chunkX, int chunkY) const;
+
+    std::unordered_map<std::int64_t, std::shared_ptr<const NavChunk>> chunks;
+};
+
+// Keeps per-chunk walkability and the chunk-level portal graph up to date
+// with the world. Nothing is checked while the world revision stands still,
+// and chunks are rebuilt only when their revision, or the revision of the
+// chunk above or below, has changed since the last build.
+class NavigationGrid {
+public:
+    NavigationGrid();
+    // Simulation thread only
+    void update(const World& world);
+    // Safe from any thread
+    std::shared_ptr<const NavSnapshot> getSnapshot() const;
+
+    // Hierarchical A*: a coarse search over the chunk portal graph picks a
+    // corridor, the block-level search is then confined to it. Returns the
+    // standing cells from start to goal, or nothing if there is no path.
+    static std::vector<sf::Vector2i> findPath(const NavSnapshot& snapshot,
+                                              const sf::Vector2i& start, const sf::Vector2i& goal);
+
+    static constexpr int ACTOR_HEIGHT = 2; // Blocks of headroom the player needs
+    // Highest ledge a jump reaches, from the player's jump physics
+    static constexpr int MAX_CLIMB = static_cast<int>(
+        Player::JUMP_FORCE * Player::JUMP_FORCE / (2.0f * Player::GRAVITY) / Block::SIZE);
+    static constexpr int MAX_DROP = Chunk::SIZE; // Bounds how far a search looks down
+    static constexpr int MAX_EXPANSIONS = 50000; // Per block-level search
+
+private:
+    std::shared_ptr<const NavSnapshot> snapshot;
+    std::uint64_t builtRevision; // World revision the snapshot was built at
+    std::vector<sf::Vector2i> loadedChunks;
+    std::unordered_set<std::int64_t> changedChunks;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "Block.hpp"
+
+// Fixed-capacity particle pool stored as structure of arrays so the
+// integration loops vectorize. All live particles are drawn with a single
+// vertex array draw call.
+class ParticleSystem {
+public:
+    explicit ParticleSystem(std::size_t capacity = 16384);
+    // Burst of debris for a broken block, tinted from its texture
+    void emitBlockDebris(int blockX, int blockY, BlockType type, int count = 24);
+    void update(float deltaTime);
+    void render(sf::RenderTarget& target);
+    std::size_t getActiveCount() const;
+
+private:
+    void kill(std::size_t index);
+
+    std::size_t capacity;
+    std::size_t active;
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> life;
+    std::vector<sf::Color> colors;
+    sf::VertexArray vertices;
+    std::mt19937 rng;
+
+    static constexpr float GRAVITY = 800.0f; // Same pull as the player
+    static constexpr float LIFETIME = 0.8f;
+    static constexpr float PARTICLE_SIZE = 4.0f;
+};
@@ -0,0 +1,19 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <future>
+#include <vector>
+#include "NavigationGrid.hpp"
+
+// Runs path searches on the job system so queries from many actors never
+// stall the simulation tick. Each query searches the navigation snapshot
+// that was current when it was requested.
+class Pathfinder {
+public:
+    explicit Pathfinder(const NavigationGrid& grid);
+
+    // Poll the future from the tick, e.g. with wait_for(std::chrono::seconds(0))
+    std::future<std::vector<sf::Vector2i>> requestPath(const sf::Vector2i& start, const sf::Vector2i& goal);
+
+private:
+    const NavigationGrid& grid;
+};
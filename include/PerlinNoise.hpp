@@ -0,0 +1,61 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Simple 2D Perlin noise implementation
+class PerlinNoise {
+private:
+    std::vector<int> p;
+    
+    static double fade(double t) {
+        return t * t * t * (t * (t * 6 - 15) + 10);
+    }
+    
+    static double lerp(double t, double a, double b) {
+        return a + t * (b - a);
+    }
+    
+    static double grad(int hash, double x, double y) {
+        int h = hash & 15;
+        double u = h < 8 ? x : y;
+        double v = h < 4 ? y : h == 12 || h == 14 ? x : 0;
+        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+    }
+    
+public:
+    PerlinNoise() {
+        p.resize(512);
+        for(int i = 0; i < 256; ++i) p[i] = i;
+        
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        std::shuffle(p.begin(), p.begin() + 256, gen);
+        
+        for(int i = 0; i < 256; ++i) p[256 + i] = p[i];
+    }
+    
+    double noise(double x, double y) const {
+        int X = static_cast<int>(std::floor(x)) & 255;
+        int Y = static_cast<int>(std::floor(y)) & 255;
+        
+        x -= std::floor(x);
+        y -= std::floor(y);
+        
+        double u = fade(x);
+        double v = fade(y);
+        
+        int A  = p[X] + Y;
+        int AA = p[A];
+        int AB = p[A + 1];
+        int B  = p[X + 1] + Y;
+        int BA = p[B];
+        int BB = p[B + 1];
+        
+        return lerp(v, lerp(u, grad(p[AA], x, y),
+                              grad(p[BA], x - 1, y)),
+                      lerp(u, grad(p[AB], x, y - 1),
+                              grad(p[BB], x - 1, y - 1)));
+    }
+};
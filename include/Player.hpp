@@ -2,15 +2,31 @@
 #include <SFML/Graphics.hpp>
 #include "World.hpp"
 
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+    bool jump = false;
+};
+
 class Player {
 public:
     Player(World& world);
     void update(float deltaTime);
-    void render(sf::RenderTarget& target);
-    void handleInput();
+    // Draws the player at a position published by the simulation thread
+    void render(sf::RenderTarget& target, const sf::Vector2f& position) const;
+    // Keyboard state goes through the window's connection, main thread only
+    static PlayerInput readKeyboard();
+    // Drive the player without a keyboard, e.g. from a script
+    void applyInput(const PlayerInput& input);
+    bool getIsOnGround() const;
     const sf::Vector2f& getPosition() const;
+    // Collision box in world pixels, the position is its bottom center
+    sf::FloatRect getBounds() const;
     void setPosition(const sf::Vector2f& pos);
 
+    static constexpr float JUMP_FORCE = -400.0f;
+    static constexpr float GRAVITY = 800.0f;
+
 private:
     World& world;
     sf::RectangleShape shape;
@@ -19,8 +35,6 @@ private:
     bool isOnGround;
 
     static constexpr float MOVE_SPEED = 200.0f;
-    static constexpr float JUMP_FORCE = -400.0f;
-    static constexpr float GRAVITY = 800.0f;
     static constexpr float MAX_FALL_SPEED = 500.0f;
     
     void applyPhysics(float deltaTime);
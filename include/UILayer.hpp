@@ -0,0 +1,17 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Widget.hpp"
+
+// Screen-space widgets drawn on top of the world. Widgets are owned by the
+// caller and receive events front to back until one consumes it.
+class UILayer {
+public:
+    void addWidget(Widget* widget);
+    bool handleEvent(const sf::Event& event);
+    // Returns the number of draw calls issued
+    std::size_t render(sf::RenderTarget& target);
+
+private:
+    std::vector<Widget*> widgets;
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Retained-mode UI element. Contents are drawn into a cached texture that is
+// only redrawn after invalidate(), so an unchanged widget costs one sprite
+// draw per frame.
+class Widget {
+public:
+    Widget(unsigned width, unsigned height);
+    virtual ~Widget() = default;
+
+    // Returns true if the event was consumed
+    virtual bool handleEvent(const sf::Event& event);
+    void render(sf::RenderTarget& target);
+    void setPosition(const sf::Vector2f& position);
+    sf::Vector2f getSize() const;
+
+protected:
+    void invalidate();
+    virtual void redraw(sf::RenderTarget& canvas) = 0;
+
+private:
+    sf::RenderTexture canvas;
+    sf::Sprite sprite;
+    sf::Vector2f size;
+    bool dirty;
+};
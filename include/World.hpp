@@ -1,36 +1,85 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+#include "BiomeMap.hpp"
 #include "Block.hpp"
-
-struct Chunk {
-    static constexpr int SIZE = 16;
-    std::vector<std::vector<Block>> blocks;
-    bool isGenerated;
-    
-    Chunk() : blocks(SIZE, std::vector<Block>(SIZE)), isGenerated(false) {}
-};
+#include "Chunk.hpp"
+#include "ChunkPool.hpp"
+#include "CompressedChunk.hpp"
 
 class World {
 public:
     World();
+    ~World();
     void update(float deltaTime);
-    void render(sf::RenderTarget& target, const sf::Vector2f& cameraPosition);
+    // Generate chunks in view around center and rebalance the hot and cold tiers
+    void stream(const sf::Vector2f& center, const sf::Vector2f& viewSize);
+    // Same for several viewers at once, chunks near any of them stay resident
+    void stream(const std::vector<sf::Vector2f>& centers, const sf::Vector2f& viewSize);
     Block* getBlock(int x, int y);
     void setBlock(int x, int y, BlockType type);
     bool isPositionSolid(float x, float y) const;
+    const Chunk* getLoadedChunk(int chunkX, int chunkY) const;
+    void getLoadedChunkPositions(std::vector<sf::Vector2i>& positions) const;
+    // Swap out the chunks that became hot or were edited, and the ones that
+    // left the hot tier, since the last call
+    void takeChunkChanges(std::vector<sf::Vector2i>& changed, std::vector<sf::Vector2i>& removed);
+    const ChunkPool& getChunkPool() const;
+    std::size_t getHotChunkCount() const;
+    std::size_t getColdChunkCount() const;
+    std::size_t getResidentChunkBytes() const;
+    // Running totals, so callers can tell generation apart from edits
+    std::uint64_t getGeneratedChunkCount() const;
+    std::uint64_t getEditedChunkCount() const; // Clean chunks dirtied by setBlock
+    // Increases whenever a block changes or a chunk enters or leaves the hot tier
+    std::uint64_t getRevision() const;
 
 private:
-    std::unordered_map<int, std::unordered_map<int, Chunk>> chunks;
-    void generateChunk(int chunkX, int chunkY);
-    void generateTerrain(Chunk& chunk, int chunkX, int chunkY);
-    void generateStructures(Chunk& chunk, int chunkX, int chunkY);
+    ChunkPool chunkPool;
+    // Map nodes come from a pool resource so evicting and loading chunks
+    // recycles them instead of going back to the system allocator
+    std::pmr::unsynchronized_pool_resource chunkNodes;
+    std::pmr::unordered_map<std::int64_t, Chunk*> chunks;
+    // Distant chunks, kept resident in compressed form
+    std::pmr::unordered_map<std::int64_t, CompressedChunk> coldChunks;
+    BiomeMap biomeMap;
+    std::vector<int> usedRegions; // Climate regions under resident chunks, sorted
+    std::uint32_t seed;
+    std::vector<std::array<int, 4>> viewRanges;      // Visible chunk range of each viewer
+    std::vector<std::array<int, 4>> residencyRanges; // View ranges at the last residency pass
+    std::size_t coldChunkBytes;
+    std::uint64_t lastRevision;
+    std::uint64_t generatedChunkCount;
+    std::uint64_t editedChunkCount;
+    std::vector<sf::Vector2i> changedChunks;
+    std::vector<sf::Vector2i> removedChunks;
+    std::vector<std::pair<sf::Vector2i, Chunk*>> pendingChunks; // Acquired but not generated yet
+
+    void markChanged(Chunk& chunk, int chunkX, int chunkY);
+    Chunk* findChunk(int chunkX, int chunkY);
+    // Generate the queued chunks in parallel on the job system
+    void generatePendingChunks();
+    void streamViewers(const sf::Vector2f* centers, std::size_t count, const sf::Vector2f& viewSize);
+    void updateResidency();
+
+    // Generation runs on job workers, it only reads shared state
+    void generateChunk(Chunk& chunk, int chunkX, int chunkY) const;
+    void generateTerrain(Chunk& chunk, int chunkX, int chunkY) const;
+    std::uint32_t chunkSeed(int chunkX, int chunkY) const;
+    void generateStructures(Chunk& chunk, int chunkX, int chunkY) const;
     float generateNoise(float x, float y) const;
-    void generateTree(Chunk& chunk, int x, int y);
+    void generateTree(Chunk& chunk, int x, int y, std::mt19937& gen) const;
 
     static constexpr int RENDER_DISTANCE = 2;
-    static constexpr int WATER_LEVEL = 60;
+    static constexpr int HOT_DISTANCE = 2;   // Chunks beyond the view kept uncompressed
+    static constexpr int COLD_DISTANCE = 32; // Chunks beyond the view kept compressed
+    static constexpr int WATER_LEVEL = 18; // Sea level row, everything below it floods
     static constexpr int STONE_LEVEL = 40;
     static constexpr float TERRAIN_SCALE = 0.05f;
-};
\ No newline at end of file
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Chunk.hpp"
+#include "FrameSnapshot.hpp"
+
+// Render thread copy of the hot chunks, kept up to date from frame snapshots
+// so drawing never touches the simulation's World
+class WorldRenderer {
+public:
+    void applyUpdates(const std::vector<ChunkUpdate>& updates);
+    // Block type as last published by the simulation, Air if not loaded
+    BlockType getBlockType(int x, int y) const;
+    // Returns the number of draw calls issued
+    std::size_t render(sf::RenderTarget& target, const sf::Vector2f& cameraPosition) const;
+
+private:
+    std::unordered_map<std::int64_t, std::array<BlockType, Chunk::SIZE * Chunk::SIZE>> chunks;
+};
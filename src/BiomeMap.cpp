@@ -0,0 +1,111 @@
+#include "BiomeMap.hpp"
+#include <algorithm>
+#include <cmath>
+
+BiomeMap::BiomeMap()
+    : regionNodes(std::pmr::pool_options{0, sizeof(Region) + 64}), regions(&regionNodes) {}
+
+const TerrainColumn& BiomeMap::getColumn(int worldX) {
+    int regionX = getRegionIndex(worldX);
+    return getRegion(regionX).columns[worldX - regionX * REGION_SIZE];
+}
+
+const TerrainColumn& BiomeMap::getCachedColumn(int worldX) const {
+    int regionX = getRegionIndex(worldX);
+    return regions.at(regionX).columns[worldX - regionX * REGION_SIZE];
+}
+
+void BiomeMap::retainRegions(const std::vector<int>& used) {
+    for (auto it = regions.begin(); it != regions.end();) {
+        if (!std::binary_search(used.begin(), used.end(), it->first)) {
+            it = regions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int BiomeMap::getRegionIndex(int worldX) {
+    return floorDiv(worldX, REGION_SIZE);
+}
+
+const BiomeMap::Region& BiomeMap::getRegion(int regionX) {
+    auto it = regions.find(regionX);
+    if (it != regions.end()) {
+        return it->second;
+    }
+
+    Region& region = regions[regionX];
+    generateRegion(region, regionX);
+    return region;
+}
+
+void BiomeMap::generateRegion(Region& region, int regionX) {
+    // Sample climate on the coarse grid, including the shared edge with the
+    // next region so neighbouring regions join up seamlessly
+    constexpr int SAMPLES = REGION_SIZE / GRID_SPACING + 1;
+    std::array<float, SAMPLES> temperatures;
+    std::array<float, SAMPLES> moistures;
+
+    for (int i = 0; i < SAMPLES; ++i) {
+        double worldX = (regionX * REGION_SIZE + i * GRID_SPACING) * CLIMATE_SCALE;
+        temperatures[i] = static_cast<float>(temperatureNoise.noise(worldX, 0.5) +
+                                             temperatureNoise.noise(worldX * 3.0, 0.5) * 0.25);
+        moistures[i] = static_cast<float>(moistureNoise.noise(worldX, 0.5) +
+                                          moistureNoise.noise(worldX * 3.0, 0.5) * 0.25);
+    }
+
+    // Interpolate the grid down to individual columns
+    for (int x = 0; x < REGION_SIZE; ++x) {
+        int cell = x / GRID_SPACING;
+        float t = static_cast<float>(x % GRID_SPACING) / GRID_SPACING;
+
+        TerrainColumn& column = region.columns[x];
+        column.temperature = temperatures[cell] + (temperatures[cell + 1] - temperatures[cell]) * t;
+        column.moisture = moistures[cell] + (moistures[cell + 1] - moistures[cell]) * t;
+        column.biome = classify(column.temperature, column.moisture);
+        column.surfaceHeight = computeSurfaceHeight(regionX * REGION_SIZE + x,
+                                                    column.temperature, column.moisture);
+    }
+}
+
+int BiomeMap::computeSurfaceHeight(int worldX, float temperature, float moisture) {
+    // Generate height using multiple noise functions for more interesting terrain
+    double scaledX = worldX * TERRAIN_SCALE;
+    double baseHeight = Chunk::SIZE - 10.0;
+    
+    // Add multiple noise components at different scales for more natural terrain
+    double noiseScale1 = 0.5; // Large-scale terrain features
+    double noiseScale2 = 2.0; // Medium details
+    double noiseScale3 = 5.0; // Small details
+    
+    double heightNoise = this->heightNoise.noise(scaledX * noiseScale1, 0) * 6.0 +
+                         this->heightNoise.noise(scaledX * noiseScale2, 0) * 3.0 +
+                         this->heightNoise.noise(scaledX * noiseScale3, 0) * 1.0;
+                         
+    // Add hills with sine waves of different periods
+    double sineComponent = sin(scaledX * 0.2) * 3.0 +
+                           sin(scaledX * 0.05) * 5.0;
+
+    // Hot, dry land is flattened into dunes, wet land sinks below sea level.
+    // Both blend continuously so biome borders have no cliffs.
+    double flatness = std::clamp((temperature - 0.1f) * 2.0f, 0.0f, 1.0f) *
+                      std::clamp(-moisture * 4.0f, 0.0f, 1.0f);
+    double oceanDepth = std::clamp((moisture - 0.2f) * 4.0f, 0.0f, 1.0f) * 24.0;
+
+    double relief = (heightNoise + sineComponent) * (1.0 - flatness * 0.7);
+    return static_cast<int>(baseHeight + relief + oceanDepth);
+}
+
+Biome BiomeMap::classify(float temperature, float moisture) {
+    if (moisture > 0.35f) {
+        return Biome::Ocean;
+    }
+    if (temperature > 0.15f && moisture < -0.05f) {
+        return Biome::Desert;
+    }
+    if (moisture > 0.05f) {
+        return Biome::Forest;
+    }
+    return Biome::Plains;
+}
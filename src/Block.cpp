@@ -4,12 +4,17 @@
 #include <stdexcept>
 
 std::map<BlockType, sf::Texture> Block::textures;
+std::map<BlockType, sf::RectangleShape> Block::shapes;
+std::map<BlockType, sf::Color> Block::averageColors;
 
-Block::Block(BlockType type) : type(type) {
-    initializeVisuals();
-}
+Block::Block(BlockType type) : type(type) {}
+
+sf::RectangleShape& Block::getShape(BlockType type) {
+    auto cached = shapes.find(type);
+    if (cached != shapes.end()) {
+        return cached->second;
+    }
 
-void Block::initializeVisuals() {
     if (textures.empty()) {
         try {
             loadTextures();
@@ -19,14 +24,9 @@ void Block::initializeVisuals() {
         }
     }
 
+    sf::RectangleShape shape;
     shape.setSize(sf::Vector2f(SIZE, SIZE));
 
-    if (type == BlockType::Air) {
-        // Skip texture assignment for Air blocks
-        shape.setTexture(nullptr);
-        return;
-    }
-
     auto it = textures.find(type);
     if (it != textures.end()) {
         shape.setTexture(&it->second);
@@ -37,10 +37,13 @@ void Block::initializeVisuals() {
 
     shape.setOutlineColor(sf::Color(0, 0, 0, 64));
     shape.setOutlineThickness(1.0f);
+
+    return shapes.emplace(type, shape).first->second;
 }
 
-void Block::render(sf::RenderTarget& target, float x, float y) {
+void Block::render(sf::RenderTarget& target, float x, float y) const {
     if (type != BlockType::Air) {
+        sf::RectangleShape& shape = getShape(type);
         shape.setPosition(x * SIZE, y * SIZE);
         target.draw(shape);
     }
@@ -58,6 +61,39 @@ BlockType Block::getType() const {
     return type;
 }
 
+sf::Color Block::getAverageColor(BlockType type) {
+    if (type == BlockType::Air) {
+        return sf::Color::Transparent;
+    }
+
+    auto cached = averageColors.find(type);
+    if (cached != averageColors.end()) {
+        return cached->second;
+    }
+
+    // Reading the texture back is slow, so it happens once per type
+    const sf::Texture* texture = getShape(type).getTexture();
+    sf::Image image = texture->copyToImage();
+    sf::Vector2u size = image.getSize();
+    unsigned long red = 0, green = 0, blue = 0, count = 0;
+    for (unsigned x = 0; x < size.x; ++x) {
+        for (unsigned y = 0; y < size.y; ++y) {
+            sf::Color pixel = image.getPixel(x, y);
+            red += pixel.r;
+            green += pixel.g;
+            blue += pixel.b;
+            ++count;
+        }
+    }
+
+    sf::Color average = count > 0
+        ? sf::Color(static_cast<sf::Uint8>(red / count), static_cast<sf::Uint8>(green / count),
+                    static_cast<sf::Uint8>(blue / count))
+        : sf::Color::White;
+    averageColors[type] = average;
+    return average;
+}
+
 void Block::loadTextures() {
     loadTexture(BlockType::Grass, "assets/grass.png");
     loadTexture(BlockType::Dirt, "assets/dirt.png");
@@ -66,6 +102,7 @@ void Block::loadTextures() {
     loadTexture(BlockType::Water, "assets/water.png");
     loadTexture(BlockType::WoodLog, "assets/wood_log.png");
     loadTexture(BlockType::Leaves, "assets/leaves.png");
+    loadTexture(BlockType::Sand, "assets/sand.png");
 }
 
 void Block::loadTexture(BlockType type, const std::string& filepath) {
@@ -0,0 +1,54 @@
+#include "ChunkPool.hpp"
+
+ChunkPool::ChunkPool(std::size_t chunksPerSlab)
+    : chunksPerSlab(chunksPerSlab > 0 ? chunksPerSlab : 1), inUse(0) {
+    addSlab();
+}
+
+Chunk* ChunkPool::acquire() {
+    if (freeList.empty()) {
+        addSlab();
+    }
+
+    Chunk* chunk = freeList.back();
+    freeList.pop_back();
+    chunk->reset();
+    ++inUse;
+    return chunk;
+}
+
+void ChunkPool::release(Chunk* chunk) {
+    if (!chunk) return;
+
+    // The free list always has room for every chunk, so this never allocates
+    freeList.push_back(chunk);
+    --inUse;
+}
+
+std::size_t ChunkPool::getCapacity() const {
+    return slabs.size() * chunksPerSlab;
+}
+
+std::size_t ChunkPool::getInUse() const {
+    return inUse;
+}
+
+std::size_t ChunkPool::getSlabCount() const {
+    return slabs.size();
+}
+
+float ChunkPool::getOccupancy() const {
+    std::size_t capacity = getCapacity();
+    return capacity > 0 ? static_cast<float>(inUse) / capacity : 0.0f;
+}
+
+void ChunkPool::addSlab() {
+    slabs.push_back(std::make_unique<Chunk[]>(chunksPerSlab));
+    freeList.reserve(getCapacity());
+
+    // Push in reverse so chunks are handed out in address order
+    Chunk* slab = slabs.back().get();
+    for (std::size_t i = chunksPerSlab; i > 0; --i) {
+        freeList.push_back(&slab[i - 1]);
+    }
+}
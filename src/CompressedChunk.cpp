@@ -0,0 +1,120 @@
+#include "CompressedChunk.hpp"
+#include <algorithm>
+#include <array>
+#include <utility>
+
+CompressedChunk::CompressedChunk()
+    : resource(std::pmr::get_default_resource()), words(nullptr), wordCount(0),
+      uniformType(BlockType::Air), bitsPerEntry(0), modified(false) {}
+
+CompressedChunk::CompressedChunk(const Chunk& chunk, std::pmr::memory_resource* resource)
+    : resource(resource), words(nullptr), wordCount(0), uniformType(chunk.blocks[0][0].getType()),
+      bitsPerEntry(0), modified(chunk.isModified) {
+    // Collect the distinct block types, there are only a handful
+    std::array<BlockType, MAX_PALETTE_SIZE> palette;
+    auto paletteEnd = palette.begin();
+    for (int x = 0; x < Chunk::SIZE; ++x) {
+        for (int y = 0; y < Chunk::SIZE; ++y) {
+            BlockType type = chunk.blocks[x][y].getType();
+            if (std::find(palette.begin(), paletteEnd, type) == paletteEnd) {
+                *paletteEnd++ = type;
+            }
+        }
+    }
+
+    // Uniform chunks (all air or all stone) keep only their block type
+    std::size_t paletteSize = paletteEnd - palette.begin();
+    if (paletteSize == 1) {
+        return;
+    }
+
+    while ((std::size_t(1) << bitsPerEntry) < paletteSize) {
+        ++bitsPerEntry;
+    }
+
+    // Entries never straddle a word boundary
+    int entriesPerWord = 64 / bitsPerEntry;
+    wordCount = static_cast<std::uint16_t>(PALETTE_WORDS + (ENTRY_COUNT + entriesPerWord - 1) / entriesPerWord);
+    words = static_cast<std::uint64_t*>(resource->allocate(wordCount * sizeof(std::uint64_t), alignof(std::uint64_t)));
+    std::fill(words, words + wordCount, 0);
+
+    auto* paletteBytes = reinterpret_cast<std::uint8_t*>(words);
+    for (std::size_t i = 0; i < paletteSize; ++i) {
+        paletteBytes[i] = static_cast<std::uint8_t>(palette[i]);
+    }
+
+    std::uint64_t* data = words + PALETTE_WORDS;
+    for (int x = 0; x < Chunk::SIZE; ++x) {
+        for (int y = 0; y < Chunk::SIZE; ++y) {
+            int index = x * Chunk::SIZE + y;
+            auto paletteIndex = static_cast<std::uint64_t>(
+                std::find(palette.begin(), paletteEnd, chunk.blocks[x][y].getType()) - palette.begin());
+            data[index / entriesPerWord] |= paletteIndex << ((index % entriesPerWord) * bitsPerEntry);
+        }
+    }
+}
+
+CompressedChunk::CompressedChunk(CompressedChunk&& other) noexcept
+    : resource(other.resource), words(std::exchange(other.words, nullptr)),
+      wordCount(std::exchange(other.wordCount, 0)), uniformType(other.uniformType),
+      bitsPerEntry(std::exchange(other.bitsPerEntry, 0)), modified(other.modified) {}
+
+CompressedChunk& CompressedChunk::operator=(CompressedChunk&& other) noexcept {
+    if (this != &other) {
+        release();
+        resource = other.resource;
+        words = std::exchange(other.words, nullptr);
+        wordCount = std::exchange(other.wordCount, 0);
+        uniformType = other.uniformType;
+        bitsPerEntry = std::exchange(other.bitsPerEntry, 0);
+        modified = other.modified;
+    }
+    return *this;
+}
+
+CompressedChunk::~CompressedChunk() {
+    release();
+}
+
+void CompressedChunk::release() {
+    if (words) {
+        resource->deallocate(words, wordCount * sizeof(std::uint64_t), alignof(std::uint64_t));
+        words = nullptr;
+        wordCount = 0;
+    }
+}
+
+void CompressedChunk::decompress(Chunk& chunk) const {
+    for (int x = 0; x < Chunk::SIZE; ++x) {
+        for (int y = 0; y < Chunk::SIZE; ++y) {
+            chunk.blocks[x][y] = Block(get(x, y));
+        }
+    }
+    chunk.isGenerated = true;
+    chunk.isModified = modified;
+}
+
+BlockType CompressedChunk::get(int x, int y) const {
+    if (bitsPerEntry == 0) {
+        return uniformType;
+    }
+
+    int entriesPerWord = 64 / bitsPerEntry;
+    int index = x * Chunk::SIZE + y;
+    std::uint64_t mask = (std::uint64_t(1) << bitsPerEntry) - 1;
+    const std::uint64_t* data = words + PALETTE_WORDS;
+    std::uint64_t paletteIndex = (data[index / entriesPerWord] >> ((index % entriesPerWord) * bitsPerEntry)) & mask;
+    return static_cast<BlockType>(reinterpret_cast<const std::uint8_t*>(words)[paletteIndex]);
+}
+
+bool CompressedChunk::isUniform() const {
+    return bitsPerEntry == 0;
+}
+
+bool CompressedChunk::isModified() const {
+    return modified;
+}
+
+std::size_t CompressedChunk::getMemoryUsage() const {
+    return sizeof(CompressedChunk) + wordCount * sizeof(std::uint64_t);
+}
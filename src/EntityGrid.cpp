@@ -0,0 +1,124 @@
+#include "EntityGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+void EntityGrid::clear() {
+    entries.clear();
+
+    // Cells nobody used since the last rebuild are dropped, the rest keep
+    // their capacity since entities rarely move far in a tick
+    for (auto it = cells.begin(); it != cells.end();) {
+        if (it->second.empty()) {
+            it = cells.erase(it);
+        } else {
+            it->second.clear();
+            ++it;
+        }
+    }
+}
+
+void EntityGrid::insert(EntityId id, const sf::FloatRect& bounds) {
+    Entry entry;
+    entry.id = id;
+    entry.bounds = bounds;
+    entry.minCellX = cellCoord(bounds.left);
+    entry.minCellY = cellCoord(bounds.top);
+    entry.maxCellX = cellCoord(bounds.left + bounds.width);
+    entry.maxCellY = cellCoord(bounds.top + bounds.height);
+
+    auto index = static_cast<std::uint32_t>(entries.size());
+    entries.push_back(entry);
+    for (int cx = entry.minCellX; cx <= entry.maxCellX; ++cx) {
+        for (int cy = entry.minCellY; cy <= entry.maxCellY; ++cy) {
+            cells[chunkKey(cx, cy)].push_back(index);
+        }
+    }
+}
+
+void EntityGrid::queryArea(const sf::FloatRect& area, std::vector<EntityId>& result) const {
+    result.clear();
+    int minCellX = cellCoord(area.left);
+    int minCellY = cellCoord(area.top);
+    int maxCellX = cellCoord(area.left + area.width);
+    int maxCellY = cellCoord(area.top + area.height);
+
+    for (int cx = minCellX; cx <= maxCellX; ++cx) {
+        for (int cy = minCellY; cy <= maxCellY; ++cy) {
+            auto cell = cells.find(chunkKey(cx, cy));
+            if (cell == cells.end()) continue;
+
+            for (std::uint32_t index : cell->second) {
+                const Entry& entry = entries[index];
+                // Entities spanning several cells are only reported from the
+                // first cell they share with the area
+                if (cx != std::max(entry.minCellX, minCellX) || cy != std::max(entry.minCellY, minCellY)) continue;
+                if (overlaps(entry.bounds, area)) {
+                    result.push_back(entry.id);
+                }
+            }
+        }
+    }
+}
+
+void EntityGrid::queryRadius(const sf::Vector2f& center, float radius, std::vector<EntityId>& result) const {
+    result.clear();
+    int minCellX = cellCoord(center.x - radius);
+    int minCellY = cellCoord(center.y - radius);
+    int maxCellX = cellCoord(center.x + radius);
+    int maxCellY = cellCoord(center.y + radius);
+
+    for (int cx = minCellX; cx <= maxCellX; ++cx) {
+        for (int cy = minCellY; cy <= maxCellY; ++cy) {
+            auto cell = cells.find(chunkKey(cx, cy));
+            if (cell == cells.end()) continue;
+
+            for (std::uint32_t index : cell->second) {
+                const Entry& entry = entries[index];
+                if (cx != std::max(entry.minCellX, minCellX) || cy != std::max(entry.minCellY, minCellY)) continue;
+
+                // Distance from the center to the closest point of the bounds
+                const sf::FloatRect& bounds = entry.bounds;
+                float dx = center.x - std::clamp(center.x, bounds.left, bounds.left + bounds.width);
+                float dy = center.y - std::clamp(center.y, bounds.top, bounds.top + bounds.height);
+                if (dx * dx + dy * dy <= radius * radius) {
+                    result.push_back(entry.id);
+                }
+            }
+        }
+    }
+}
+
+void EntityGrid::findOverlappingPairs(std::vector<std::pair<EntityId, EntityId>>& pairs) const {
+    pairs.clear();
+    for (const auto& cell : cells) {
+        const std::vector<std::uint32_t>& indices = cell.second;
+        int cx = chunkKeyX(cell.first);
+        int cy = chunkKeyY(cell.first);
+
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            const Entry& a = entries[indices[i]];
+            for (std::size_t j = i + 1; j < indices.size(); ++j) {
+                const Entry& b = entries[indices[j]];
+                // A pair sharing several cells is only reported from the
+                // first cell of their overlap
+                if (cx != std::max(a.minCellX, b.minCellX) || cy != std::max(a.minCellY, b.minCellY)) continue;
+                if (overlaps(a.bounds, b.bounds)) {
+                    pairs.emplace_back(a.id, b.id);
+                }
+            }
+        }
+    }
+}
+
+std::size_t EntityGrid::getEntityCount() const {
+    return entries.size();
+}
+
+int EntityGrid::cellCoord(float position) {
+    return static_cast<int>(std::floor(position / CELL_SIZE));
+}
+
+bool EntityGrid::overlaps(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return a.left <= b.left + b.width && b.left <= a.left + a.width &&
+           a.top <= b.top + b.height && b.top <= a.top + a.height;
+}
@@ -1,13 +1,59 @@
 #include "Game.hpp"
+#include "JobSystem.hpp"
+#include "Metrics.hpp"
 #include "cmath"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 
-Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), WINDOW_TITLE) {
+namespace {
+MetricsRegistry& registry = MetricsRegistry::instance();
+Histogram& tickDuration = registry.addHistogram("blockworld_tick_seconds", "Simulation tick duration",
+                                                MetricsRegistry::latencyBuckets());
+Gauge& residentChunkBytes = registry.addGauge("blockworld_resident_chunk_bytes", "Memory held by hot and cold chunks");
+Gauge& hotChunks = registry.addGauge("blockworld_hot_chunks", "Uncompressed chunks in memory");
+Gauge& coldChunks = registry.addGauge("blockworld_cold_chunks", "Compressed chunks in memory");
+Gauge& chunkPoolCapacity = registry.addGauge("blockworld_chunk_pool_capacity", "Chunks the pool can hand out without growing");
+Gauge& chunkPoolInUse = registry.addGauge("blockworld_chunk_pool_in_use", "Chunks currently handed out by the pool");
+Gauge& chunkPoolOccupancy = registry.addGauge("blockworld_chunk_pool_occupancy_percent", "Share of the pool capacity in use");
+Gauge& jobsQueued = registry.addGauge("blockworld_jobs_queued", "Jobs waiting in the worker queues");
+Gauge& drawCalls = registry.addGauge("blockworld_draw_calls", "Draw calls issued for the last frame");
+
+// Player input crosses to the simulation thread as one lock-free byte
+std::uint8_t packInput(const PlayerInput& input) {
+    return static_cast<std::uint8_t>(input.left | (input.right << 1) | (input.jump << 2));
+}
+
+PlayerInput unpackInput(std::uint8_t bits) {
+    PlayerInput input;
+    input.left = bits & 1;
+    input.right = bits & 2;
+    input.jump = bits & 4;
+    return input;
+}
+}
+
+Game::Game()
+    : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), WINDOW_TITLE),
+      running(false), simulationFrame(0), playerInput(0), renderedFrame(0) {
     window.setFramerateLimit(60);
     
     world = std::make_unique<World>();
     player = std::make_unique<Player>(*world);
     camera = std::make_unique<Camera>(window);
     inventory = std::make_unique<Inventory>();
+    navigation = std::make_unique<NavigationGrid>();
+    pathfinder = std::make_unique<Pathfinder>(*navigation);
+    worldRenderer = std::make_unique<WorldRenderer>();
+    particles = std::make_unique<ParticleSystem>();
+
+    // Metrics are only exported when a textfile path is configured
+    if (const char* metricsPath = std::getenv("BLOCKWORLD_METRICS_FILE")) {
+        metricsExporter = std::make_unique<MetricsExporter>(metricsPath);
+    }
+
+    inventory->layout(window.getDefaultView().getSize());
+    ui.addWidget(inventory.get());
 
     // Find spawn point at the center of the world (x=0)
     int spawnX = 0;
@@ -27,22 +73,42 @@ Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), WINDOW_TITLE)
 
     player->setPosition(sf::Vector2f(spawnX * Block::SIZE + Block::SIZE/2, spawnY * Block::SIZE));
     camera->setPosition(player->getPosition());
+
+    // Publish the starting state so the first frame has something to draw
+    update(0.0f);
+    publishSnapshot();
+}
+
+Game::~Game() {
+    running = false;
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
 }
 
 void Game::run() {
-    sf::Clock clock;
+    running = true;
+    simulationThread = std::thread(&Game::simulate, this);
+
+    sf::Clock frameClock;
     while (window.isOpen()) {
-        float deltaTime = clock.restart().asSeconds();
-        
+        float deltaTime = frameClock.restart().asSeconds();
+
         processEvents();
-        update(deltaTime);
-        render();
+        render(snapshots.acquireLatest(), deltaTime);
     }
+
+    running = false;
+    simulationThread.join();
 }
 
 void Game::processEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
+        if (ui.handleEvent(event)) {
+            continue;
+        }
+
         if (event.type == sf::Event::Closed) {
             window.close();
         }
@@ -57,38 +123,142 @@ void Game::processEvents() {
             int blockX = static_cast<int>(std::floor(worldPos.x / Block::SIZE));
             int blockY = static_cast<int>(std::floor(worldPos.y / Block::SIZE));
             
+            // Edits are applied by the simulation thread on its next tick
             if (event.mouseButton.button == sf::Mouse::Left) {
-                // Break block
-                world->setBlock(blockX, blockY, BlockType::Air);
+                // Break block. The renderer's copy may lag the simulation,
+                // so it only decides the debris, never whether to break.
+                BlockType brokenType = worldRenderer->getBlockType(blockX, blockY);
+                if (edits.push({blockX, blockY, BlockType::Air}) && brokenType != BlockType::Air) {
+                    particles->emitBlockDebris(blockX, blockY, brokenType);
+                }
             }
             else if (event.mouseButton.button == sf::Mouse::Right) {
                 // Place block
                 BlockType selectedType = inventory->getSelectedType();
                 if (selectedType != BlockType::Air) {
-                    world->setBlock(blockX, blockY, selectedType);
+                    edits.push({blockX, blockY, selectedType});
                 }
             }
         }
     }
+
+    // Sample the keys here, SFML shares one display connection between the
+    // keyboard and the window events
+    playerInput.store(packInput(Player::readKeyboard()));
+}
+
+void Game::simulate() {
+    sf::Clock clock;
+    while (running) {
+        float deltaTime = clock.restart().asSeconds();
+
+        update(deltaTime);
+        publishSnapshot();
+
+        // Run at a fixed tick rate independent of the render frame rate
+        float remaining = TICK_DURATION - clock.getElapsedTime().asSeconds();
+        if (remaining > 0.0f) {
+            sf::sleep(sf::seconds(remaining));
+        }
+    }
 }
 
 void Game::update(float deltaTime) {
-    player->handleInput();
+    auto start = std::chrono::steady_clock::now();
+
+    // Finish background work that hands results back to the simulation
+    JobSystem::instance().processSimulationCallbacks();
+
+    BlockEdit edit;
+    while (edits.pop(edit)) {
+        world->setBlock(edit.x, edit.y, edit.type);
+    }
+
+    player->applyInput(unpackInput(playerInput.load()));
     player->update(deltaTime);
-    camera->update(player->getPosition());
-    inventory->handleInput();
+    world->stream(player->getPosition(), sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+    navigation->update(*world);
+
+    residentChunkBytes.set(static_cast<std::int64_t>(world->getResidentChunkBytes()));
+    hotChunks.set(static_cast<std::int64_t>(world->getHotChunkCount()));
+    coldChunks.set(static_cast<std::int64_t>(world->getColdChunkCount()));
+    const ChunkPool& pool = world->getChunkPool();
+    chunkPoolCapacity.set(static_cast<std::int64_t>(pool.getCapacity()));
+    chunkPoolInUse.set(static_cast<std::int64_t>(pool.getInUse()));
+    chunkPoolOccupancy.set(static_cast<std::int64_t>(std::lround(pool.getOccupancy() * 100.0f)));
+    jobsQueued.set(static_cast<std::int64_t>(JobSystem::instance().getQueuedCount()));
+    tickDuration.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+void Game::publishSnapshot() {
+    ++simulationFrame;
+
+    // Forget updates the renderer has already picked up
+    std::uint64_t consumed = snapshots.getConsumedFrame();
+    auto acknowledged = [consumed](const ChunkUpdate& update) {
+        return update.frame <= consumed;
+    };
+    pendingUpdates.erase(std::remove_if(pendingUpdates.begin(), pendingUpdates.end(), acknowledged),
+                         pendingUpdates.end());
+
+    auto pendingFor = [this](const sf::Vector2i& position) -> ChunkUpdate& {
+        for (auto& update : pendingUpdates) {
+            if (update.position == position) return update;
+        }
+        pendingUpdates.emplace_back();
+        pendingUpdates.back().position = position;
+        return pendingUpdates.back();
+    };
+
+    // Removals first, a chunk can leave and come back within one tick
+    world->takeChunkChanges(changedChunks, removedChunks);
+    for (const auto& position : removedChunks) {
+        ChunkUpdate& update = pendingFor(position);
+        update.frame = simulationFrame;
+        update.removed = true;
+    }
+    for (const auto& position : changedChunks) {
+        const Chunk* chunk = world->getLoadedChunk(position.x, position.y);
+        if (!chunk) continue;
+
+        ChunkUpdate& update = pendingFor(position);
+        update.frame = simulationFrame;
+        update.removed = false;
+        for (int x = 0; x < Chunk::SIZE; ++x) {
+            for (int y = 0; y < Chunk::SIZE; ++y) {
+                update.blocks[x * Chunk::SIZE + y] = chunk->blocks[x][y].getType();
+            }
+        }
+    }
+
+    FrameSnapshot& snapshot = snapshots.getBack();
+    snapshot.frame = simulationFrame;
+    snapshot.playerPosition = player->getPosition();
+    snapshot.cameraTarget = player->getPosition();
+    snapshot.chunkUpdates = pendingUpdates;
+    snapshots.publish();
 }
 
-void Game::render() {
+void Game::render(const FrameSnapshot& snapshot, float deltaTime) {
+    if (snapshot.frame != renderedFrame) {
+        worldRenderer->applyUpdates(snapshot.chunkUpdates);
+        renderedFrame = snapshot.frame;
+    }
+    camera->update(snapshot.cameraTarget);
+    particles->update(deltaTime);
+
     window.clear(sf::Color(135, 206, 235)); // Sky blue background
     
     window.setView(camera->getView());
-    world->render(window, camera->getPosition());
-    player->render(window);
+    std::size_t draws = worldRenderer->render(window, camera->getPosition());
+    particles->render(window);
+    player->render(window, snapshot.playerPosition);
+    draws += particles->getActiveCount() > 0 ? 2 : 1;
     
     // Reset view for UI
     window.setView(window.getDefaultView());
-    inventory->render(window);
+    draws += ui.render(window);
+    drawCalls.set(static_cast<std::int64_t>(draws));
     
     window.display();
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 #include "Inventory.hpp"
 
-Inventory::Inventory() : selectedSlot(0), slots(SLOT_COUNT) {
+Inventory::Inventory()
+    : Widget(static_cast<unsigned>(SLOT_COUNT * (SLOT_SIZE + SLOT_PADDING) + MARGIN * 2),
+             static_cast<unsigned>(SLOT_SIZE + MARGIN * 2)),
+      selectedSlot(0), slots(SLOT_COUNT) {
     slotShape.setSize(sf::Vector2f(SLOT_SIZE, SLOT_SIZE));
     slotShape.setFillColor(sf::Color(128, 128, 128, 200));
     slotShape.setOutlineColor(sf::Color::White);
@@ -19,38 +22,41 @@ Inventory::Inventory() : selectedSlot(0), slots(SLOT_COUNT) {
     slots[2].quantity = 64;
 }
 
-void Inventory::render(sf::RenderTarget& target) {
-    sf::Vector2f windowSize = target.getView().getSize();
-    float startX = (windowSize.x - (SLOT_COUNT * (SLOT_SIZE + SLOT_PADDING))) / 2;
-    float y = windowSize.y - SLOT_SIZE - 10.0f;
-    
+void Inventory::layout(const sf::Vector2f& screenSize) {
+    float startX = (screenSize.x - (SLOT_COUNT * (SLOT_SIZE + SLOT_PADDING))) / 2;
+    float y = screenSize.y - SLOT_SIZE - 10.0f;
+    setPosition(sf::Vector2f(startX - MARGIN, y - MARGIN));
+}
+
+void Inventory::redraw(sf::RenderTarget& canvas) {
     for (int i = 0; i < SLOT_COUNT; ++i) {
-        float x = startX + i * (SLOT_SIZE + SLOT_PADDING);
+        float x = MARGIN + i * (SLOT_SIZE + SLOT_PADDING);
+        float y = MARGIN;
         
         // Draw slot background
         if (i == selectedSlot) {
             selectedSlotShape.setPosition(x, y);
-            target.draw(selectedSlotShape);
+            canvas.draw(selectedSlotShape);
         } else {
             slotShape.setPosition(x, y);
-            target.draw(slotShape);
+            canvas.draw(slotShape);
         }
         
         // Draw block preview if slot is not empty
         if (slots[i].quantity > 0) {
-            Block block(slots[i].blockType);
-            block.render(target, x / Block::SIZE, y / Block::SIZE);
+            Block(slots[i].blockType).render(canvas, x / Block::SIZE, y / Block::SIZE);
         }
     }
 }
 
-void Inventory::handleInput() {
+bool Inventory::handleEvent(const sf::Event& event) {
     // Number keys 1-9 for slot selection
-    for (int i = 0; i < SLOT_COUNT; ++i) {
-        if (sf::Keyboard::isKeyPressed(static_cast<sf::Keyboard::Key>(sf::Keyboard::Num1 + i))) {
-            selectSlot(i);
-        }
+    if (event.type == sf::Event::KeyPressed &&
+        event.key.code >= sf::Keyboard::Num1 && event.key.code <= sf::Keyboard::Num9) {
+        selectSlot(event.key.code - sf::Keyboard::Num1);
+        return true;
     }
+    return false;
 }
 
 void Inventory::addItem(BlockType type, int count) {
@@ -61,6 +67,7 @@ void Inventory::addItem(BlockType type, int count) {
             int add = std::min(count, space);
             slot.quantity += add;
             count -= add;
+            invalidate();
             
             if (count == 0) return;
         }
@@ -73,6 +80,7 @@ void Inventory::addItem(BlockType type, int count) {
                 slot.blockType = type;
                 slot.quantity = std::min(count, 64);
                 count -= slot.quantity;
+                invalidate();
                 
                 if (count == 0) return;
             }
@@ -95,6 +103,7 @@ bool Inventory::removeItem(BlockType type, int count) {
     }
     
     // Remove items
+    invalidate();
     for (auto& slot : slots) {
         if (slot.blockType == type) {
             int remove = std::min(count, slot.quantity);
@@ -115,8 +124,9 @@ bool Inventory::removeItem(BlockType type, int count) {
 }
 
 void Inventory::selectSlot(int slot) {
-    if (slot >= 0 && slot < SLOT_COUNT) {
+    if (slot >= 0 && slot < SLOT_COUNT && slot != selectedSlot) {
         selectedSlot = slot;
+        invalidate();
     }
 }
 
@@ -0,0 +1,331 @@
+#include "JobSystem.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+MetricsRegistry& registry = MetricsRegistry::instance();
+Gauge& jobWorkers = registry.addGauge("blockworld_job_workers", "Job system worker threads");
+Counter& jobSteals = registry.addCounter("blockworld_job_steals_total", "Jobs taken from another worker's queue");
+Histogram& jobDuration = registry.addHistogram("blockworld_job_seconds",
+                                               "Job run time, the sum over the worker count is utilization",
+                                               MetricsRegistry::latencyBuckets());
+
+// Worker index of the current thread, -1 for threads outside the pool
+thread_local int currentWorker = -1;
+}
+
+JobSystem& JobSystem::instance() {
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+    : nextWorker(0), queued(0), stopping(false), sleepers(0) {
+    // One core stays free for the thread that submits most of the work
+    if (workerCount == 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        workerCount = std::clamp(cores > 1 ? cores - 1 : 1u, 1u, 63u);
+    }
+
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers[i]->thread = std::thread(&JobSystem::workerLoop, this, static_cast<int>(i));
+    }
+    jobWorkers.set(workerCount);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+JobSystem::JobHandle JobSystem::submit(std::function<void()> work, Priority priority,
+                                       const std::vector<JobHandle>& dependencies) {
+    auto job = std::make_shared<Job>();
+    job->work = std::move(work);
+    job->priority = priority;
+
+    // The extra count keeps the job from being scheduled while the
+    // dependencies are still being registered
+    job->unfinishedDependencies.store(static_cast<int>(dependencies.size()) + 1);
+    for (const auto& dependency : dependencies) {
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (dependency->done) {
+            job->unfinishedDependencies.fetch_sub(1);
+        } else {
+            dependency->dependents.push_back(job);
+        }
+    }
+
+    if (job->unfinishedDependencies.fetch_sub(1) == 1) {
+        schedule(job);
+    }
+    return job;
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    while (!job->done.load(std::memory_order_acquire)) {
+        if (!runOne(job->priority)) {
+            std::this_thread::yield();
+        }
+    }
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
+
+bool JobSystem::isDone(const JobHandle& job) {
+    return job->done.load(std::memory_order_acquire);
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grainSize,
+                            const std::function<void(std::size_t begin, std::size_t end)>& body,
+                            Priority priority) {
+    if (count == 0) return;
+    grainSize = std::max<std::size_t>(grainSize, 1);
+
+    // A single range is not worth a round trip through the queues
+    std::size_t ranges = (count + grainSize - 1) / grainSize;
+    if (ranges == 1) {
+        body(0, count);
+        return;
+    }
+
+    ForState state;
+    state.body = &body;
+    state.count = count;
+    state.grainSize = grainSize;
+    state.next = 0;
+
+    // Runners claim ranges until none are left, so a handful of them cover
+    // any range count. They come from a pool and capture a single pointer,
+    // so a steady stream of loops never allocates.
+    std::size_t runnerCount = std::min<std::size_t>(ranges - 1, workers.size());
+    std::array<JobHandle, MAX_RUNNERS> runners;
+    runnerCount = std::min(runnerCount, runners.size());
+    {
+        std::lock_guard<std::mutex> lock(runnerMutex);
+        for (std::size_t i = 0; i < runnerCount; ++i) {
+            if (spareRunners.empty()) {
+                runners[i] = std::make_shared<Job>();
+            } else {
+                runners[i] = std::move(spareRunners.back());
+                spareRunners.pop_back();
+            }
+        }
+    }
+    for (std::size_t i = 0; i < runnerCount; ++i) {
+        Job& runner = *runners[i];
+        runner.work = [statePointer = &state]() { runRanges(*statePointer); };
+        runner.priority = priority;
+        runner.done.store(false, std::memory_order_relaxed);
+        schedule(runners[i]);
+    }
+
+    runRanges(state);
+    for (std::size_t i = 0; i < runnerCount; ++i) {
+        wait(runners[i]);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(runnerMutex);
+        for (std::size_t i = 0; i < runnerCount; ++i) {
+            spareRunners.push_back(std::move(runners[i]));
+        }
+    }
+
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+}
+
+void JobSystem::runRanges(ForState& state) {
+    while (true) {
+        std::size_t begin = state.next.fetch_add(state.grainSize);
+        if (begin >= state.count) return;
+
+        try {
+            (*state.body)(begin, std::min(begin + state.grainSize, state.count));
+        } catch (...) {
+            // Keep the first failure and stop handing out ranges
+            std::lock_guard<std::mutex> lock(state.errorMutex);
+            if (!state.error) {
+                state.error = std::current_exception();
+            }
+            state.next = state.count;
+        }
+    }
+}
+
+void JobSystem::runOnSimulationThread(std::function<void()> callback, const std::vector<JobHandle>& after) {
+    if (after.empty()) {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        callbacks.push_back(std::move(callback));
+        return;
+    }
+
+    // Defer the hand-over until the dependencies have finished
+    auto shared = std::make_shared<std::function<void()>>(std::move(callback));
+    submit([this, shared]() {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        callbacks.push_back(std::move(*shared));
+    }, Priority::High, after);
+}
+
+void JobSystem::processSimulationCallbacks() {
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        runningCallbacks.swap(callbacks);
+    }
+    for (auto& callback : runningCallbacks) {
+        callback();
+    }
+    runningCallbacks.clear();
+}
+
+unsigned JobSystem::getWorkerCount() const {
+    return static_cast<unsigned>(workers.size());
+}
+
+std::size_t JobSystem::getQueuedCount() const {
+    return static_cast<std::size_t>(std::max<std::int64_t>(queued.load(std::memory_order_relaxed), 0));
+}
+
+void JobSystem::workerLoop(int index) {
+    currentWorker = index;
+    while (!stopping) {
+        if (runOne()) continue;
+
+        // Announce the sleep before checking for work, schedule() publishes
+        // work before checking for sleepers, so one of them sees the other
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1);
+        wakeup.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        sleepers.fetch_sub(1);
+    }
+}
+
+bool JobSystem::runOne(Priority lowest) {
+    JobHandle job = take(currentWorker, lowest);
+    if (!job) return false;
+    execute(job);
+    return true;
+}
+
+void JobSystem::JobQueue::pushBack(JobHandle job) {
+    if (size == slots.size()) {
+        // Unroll into a ring twice the size
+        std::vector<JobHandle> grown(std::max<std::size_t>(slots.size() * 2, 16));
+        for (std::size_t i = 0; i < size; ++i) {
+            grown[i] = std::move(slots[(head + i) % slots.size()]);
+        }
+        slots.swap(grown);
+        head = 0;
+    }
+    slots[(head + size) % slots.size()] = std::move(job);
+    ++size;
+}
+
+JobSystem::JobHandle JobSystem::JobQueue::popBack() {
+    --size;
+    return std::move(slots[(head + size) % slots.size()]);
+}
+
+JobSystem::JobHandle JobSystem::JobQueue::popFront() {
+    JobHandle job = std::move(slots[head]);
+    head = (head + 1) % slots.size();
+    --size;
+    return job;
+}
+
+JobSystem::JobHandle JobSystem::take(int self, Priority lowest) {
+    const int count = static_cast<int>(workers.size());
+
+    for (int priority = 0; priority <= static_cast<int>(lowest); ++priority) {
+        // Own work first, newest first while it is still warm in cache
+        if (self >= 0) {
+            Worker& worker = *workers[self];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& queue = worker.queues[priority];
+            if (!queue.empty()) {
+                JobHandle job = queue.popBack();
+                queued.fetch_sub(1);
+                return job;
+            }
+        }
+
+        // Then steal the oldest work from the other workers
+        int start = self >= 0 ? self + 1 : 0;
+        for (int offset = 0; offset < count; ++offset) {
+            int victim = (start + offset) % count;
+            if (victim == self) continue;
+
+            Worker& worker = *workers[victim];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& queue = worker.queues[priority];
+            if (!queue.empty()) {
+                JobHandle job = queue.popFront();
+                queued.fetch_sub(1);
+                jobSteals.increment();
+                return job;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::schedule(const JobHandle& job) {
+    // Workers keep what they spawn, outside threads spread it round-robin
+    int target = currentWorker >= 0
+        ? currentWorker
+        : static_cast<int>(nextWorker.fetch_add(1) % workers.size());
+
+    {
+        Worker& worker = *workers[target];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[static_cast<int>(job->priority)].pushBack(job);
+    }
+    queued.fetch_add(1);
+
+    // Busy workers find the job on their own, only sleeping ones need waking
+    if (sleepers.load() > 0) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wakeup.notify_one();
+    }
+}
+
+void JobSystem::execute(const JobHandle& job) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+        job->work();
+    } catch (...) {
+        job->error = std::current_exception();
+    }
+    jobDuration.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    // Nothing touches the job after it is marked done, parallelFor reuses it
+    job->work = nullptr;
+    std::vector<JobHandle> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        dependents.swap(job->dependents);
+        job->done.store(true, std::memory_order_release);
+    }
+
+    for (const auto& dependent : dependents) {
+        if (dependent->unfinishedDependencies.fetch_sub(1) == 1) {
+            schedule(dependent);
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#include "Metrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+std::atomic<std::size_t> nextShard(0);
+
+// Threads take shards round-robin the first time they record
+std::size_t threadShard() {
+    thread_local std::size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+}
+
+Counter::Counter() : shards(std::make_unique<Shard[]>(METRIC_SHARDS)) {}
+
+void Counter::increment(std::uint64_t amount) {
+    shards[threadShard()].value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+std::uint64_t Counter::get() const {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < METRIC_SHARDS; ++i) {
+        total += shards[i].value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds(std::move(bounds)), shards(std::make_unique<Shard[]>(METRIC_SHARDS)) {
+    std::sort(this->bounds.begin(), this->bounds.end());
+    if (this->bounds.size() + 1 > MAX_BUCKETS) {
+        throw std::invalid_argument("Too many histogram buckets");
+    }
+}
+
+void Histogram::observe(double value) {
+    std::size_t bucket = std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+    Shard& shard = shards[threadShard()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+
+    // Only threads sharing a shard ever retry
+    double current = shard.sum.load(std::memory_order_relaxed);
+    while (!shard.sum.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+}
+
+const std::vector<double>& Histogram::getBounds() const {
+    return bounds;
+}
+
+std::uint64_t Histogram::getBucketCount(std::size_t bucket) const {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < METRIC_SHARDS; ++i) {
+        total += shards[i].buckets[bucket].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::uint64_t Histogram::getCount() const {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < METRIC_SHARDS; ++i) {
+        total += shards[i].count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+double Histogram::getSum() const {
+    double total = 0.0;
+    for (std::size_t i = 0; i < METRIC_SHARDS; ++i) {
+        total += shards[i].sum.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+Counter& MetricsRegistry::addCounter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({name, help, Kind::Counter, std::make_unique<Counter>(), nullptr, nullptr});
+    return *entries.back().counter;
+}
+
+Gauge& MetricsRegistry::addGauge(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({name, help, Kind::Gauge, nullptr, std::make_unique<Gauge>(), nullptr});
+    return *entries.back().gauge;
+}
+
+Histogram& MetricsRegistry::addHistogram(const std::string& name, const std::string& help,
+                                         std::vector<double> bounds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({name, help, Kind::Histogram, nullptr, nullptr,
+                       std::make_unique<Histogram>(std::move(bounds))});
+    return *entries.back().histogram;
+}
+
+std::string MetricsRegistry::exportText() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream out;
+
+    for (const auto& entry : entries) {
+        out << "# HELP " << entry.name << " " << entry.help << "\n";
+        switch (entry.kind) {
+        case Kind::Counter:
+            out << "# TYPE " << entry.name << " counter\n";
+            out << entry.name << " " << entry.counter->get() << "\n";
+            break;
+        case Kind::Gauge:
+            out << "# TYPE " << entry.name << " gauge\n";
+            out << entry.name << " " << entry.gauge->get() << "\n";
+            break;
+        case Kind::Histogram: {
+            out << "# TYPE " << entry.name << " histogram\n";
+            const Histogram& histogram = *entry.histogram;
+            std::uint64_t cumulative = 0;
+            for (std::size_t i = 0; i < histogram.getBounds().size(); ++i) {
+                cumulative += histogram.getBucketCount(i);
+                out << entry.name << "_bucket{le=\"" << histogram.getBounds()[i] << "\"} " << cumulative << "\n";
+            }
+            cumulative += histogram.getBucketCount(histogram.getBounds().size());
+            out << entry.name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+            out << entry.name << "_sum " << histogram.getSum() << "\n";
+            // Shards are read one by one, so the count comes from the same
+            // bucket reads to stay equal to the +Inf bucket
+            out << entry.name << "_count " << cumulative << "\n";
+            break;
+        }
+        }
+    }
+    return out.str();
+}
+
+bool MetricsRegistry::writeTextfile(const std::string& path) const {
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file << exportText();
+        if (!file) {
+            return false;
+        }
+    }
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+std::vector<double> MetricsRegistry::latencyBuckets() {
+    return {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.016, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0};
+}
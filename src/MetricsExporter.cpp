@@ -0,0 +1,38 @@
+#include "MetricsExporter.hpp"
+#include "Metrics.hpp"
+#include <chrono>
+#include <iostream>
+
+MetricsExporter::MetricsExporter(const std::string& path, float intervalSeconds)
+    : path(path), intervalSeconds(intervalSeconds), running(true) {
+    thread = std::thread(&MetricsExporter::run, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+    running = false;
+    thread.join();
+
+    // Leave the final values behind for the collector
+    MetricsRegistry::instance().writeTextfile(path);
+}
+
+void MetricsExporter::run() {
+    using Clock = std::chrono::steady_clock;
+    auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(intervalSeconds));
+    auto nextExport = Clock::now();
+    bool reportedFailure = false;
+
+    while (running) {
+        if (Clock::now() >= nextExport) {
+            bool written = MetricsRegistry::instance().writeTextfile(path);
+            if (!written && !reportedFailure) {
+                std::cerr << "Failed to write metrics file: " << path << std::endl;
+            }
+            reportedFailure = !written;
+            nextExport += interval;
+        }
+
+        // Sleep in short steps so shutdown is not delayed by a whole interval
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
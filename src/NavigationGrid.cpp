@@ -0,0 +1,404 @@
+#include "NavigationGrid.hpp"
+#include "World.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <unordered_set>
+
+namespace {
+
+// Block-level queries against a snapshot. Consecutive probes almost always
+// land in the same chunk, so the last chunk is cached instead of going
+// through the hash map every time.
+class NavQuery {
+public:
+    explicit NavQuery(const NavSnapshot& snapshot)
+        : snapshot(snapshot), cachedKey(0), cached(nullptr), hasCached(false) {}
+
+    // Blocks in chunks that are not loaded count as impassable
+    bool isPassable(int x, int y) {
+        int localX, localY;
+        const NavChunk* chunk = find(x, y, localX, localY);
+        return chunk && (chunk->passable[localX] >> localY) & 1;
+    }
+
+    bool isStandable(int x, int y) {
+        int localX, localY;
+        const NavChunk* chunk = find(x, y, localX, localY);
+        return chunk && (chunk->standable[localX] >> localY) & 1;
+    }
+
+    // Where an actor standing at (x, y) ends up after moving one column in
+    // direction: walking, dropping off a ledge or jumping up onto one
+    bool step(int x, int y, int direction, int& targetY) {
+        int nextX = x + direction;
+
+        bool clear = true;
+        for (int h = 0; h < NavigationGrid::ACTOR_HEIGHT; ++h) {
+            clear = clear && isPassable(nextX, y - h);
+        }
+
+        if (clear) {
+            for (int drop = 0; drop <= NavigationGrid::MAX_DROP; ++drop) {
+                if (!isPassable(nextX, y + drop)) return false;
+                if (isStandable(nextX, y + drop)) {
+                    targetY = y + drop;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Blocked, jump onto the lowest ledge within reach
+        for (int climb = 1; climb <= NavigationGrid::MAX_CLIMB; ++climb) {
+            if (!isPassable(x, y - NavigationGrid::ACTOR_HEIGHT + 1 - climb)) return false;
+            if (isStandable(nextX, y - climb)) {
+                targetY = y - climb;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const NavChunk* find(int x, int y, int& localX, int& localY) {
+        int chunkX = floorDiv(x, Chunk::SIZE);
+        int chunkY = floorDiv(y, Chunk::SIZE);
+        localX = x - chunkX * Chunk::SIZE;
+        localY = y - chunkY * Chunk::SIZE;
+
+        std::int64_t key = chunkKey(chunkX, chunkY);
+        if (!hasCached || key != cachedKey) {
+            cached = snapshot.getChunk(chunkX, chunkY);
+            cachedKey = key;
+            hasCached = true;
+        }
+        return cached;
+    }
+
+    const NavSnapshot& snapshot;
+    std::int64_t cachedKey;
+    const NavChunk* cached;
+    bool hasCached;
+};
+
+bool isSolid(const Chunk* chunk, int x, int y) {
+    return chunk && chunk->blocks[x][y].isSolid();
+}
+
+std::shared_ptr<NavChunk> buildChunk(const sf::Vector2i& position, const Chunk& chunk,
+                                     const Chunk* above, const Chunk* below) {
+    auto nav = std::make_shared<NavChunk>();
+    nav->position = position;
+    nav->revision = chunk.revision;
+    nav->revisionAbove = above ? above->revision : 0;
+    nav->revisionBelow = below ? below->revision : 0;
+
+    // Solidity of a column including the neighbouring rows, unloaded space
+    // above counts as open sky and unloaded space below as no ground
+    auto solidAt = [&](int x, int y) {
+        if (y < 0) return isSolid(above, x, y + Chunk::SIZE);
+        if (y >= Chunk::SIZE) return isSolid(below, x, y - Chunk::SIZE);
+        return chunk.blocks[x][y].isSolid();
+    };
+
+    for (int x = 0; x < Chunk::SIZE; ++x) {
+        for (int y = 0; y < Chunk::SIZE; ++y) {
+            if (solidAt(x, y)) continue;
+            nav->passable[x] |= static_cast<std::uint16_t>(1u << y);
+
+            bool headroom = true;
+            for (int h = 1; h < NavigationGrid::ACTOR_HEIGHT; ++h) {
+                headroom = headroom && !solidAt(x, y - h);
+            }
+            bool ground = y + 1 < Chunk::SIZE ? solidAt(x, y + 1) : (below && solidAt(x, y + 1));
+            if (headroom && ground) {
+                nav->standable[x] |= static_cast<std::uint16_t>(1u << y);
+            }
+        }
+    }
+    return nav;
+}
+
+// Record which neighbouring chunks a move out of this chunk can reach
+void computeExits(const NavSnapshot& snapshot, NavChunk& nav) {
+    NavQuery query(snapshot);
+    nav.exits = 0;
+
+    for (int x = 0; x < Chunk::SIZE; ++x) {
+        for (int y = 0; y < Chunk::SIZE; ++y) {
+            if (!((nav.standable[x] >> y) & 1)) continue;
+
+            int worldX = nav.position.x * Chunk::SIZE + x;
+            int worldY = nav.position.y * Chunk::SIZE + y;
+            for (int direction : {-1, 1}) {
+                int targetY;
+                if (!query.step(worldX, worldY, direction, targetY)) continue;
+
+                int dx = floorDiv(worldX + direction, Chunk::SIZE) - nav.position.x;
+                int dy = floorDiv(targetY, Chunk::SIZE) - nav.position.y;
+                if (dx != 0 || dy != 0) {
+                    nav.exits |= static_cast<std::uint16_t>(1u << ((dy + 1) * 3 + (dx + 1)));
+                }
+            }
+        }
+    }
+}
+
+// Move a point to the nearest standing cell at or just below it
+bool snapToGround(NavQuery& query, sf::Vector2i& cell) {
+    for (int drop = 0; drop <= NavigationGrid::ACTOR_HEIGHT + 1; ++drop) {
+        if (query.isStandable(cell.x, cell.y + drop)) {
+            cell.y += drop;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Coarse A* over chunks, connected wherever the exits allow
+std::vector<std::int64_t> findCorridor(const NavSnapshot& snapshot,
+                                       const sf::Vector2i& startChunk, const sf::Vector2i& goalChunk) {
+    using Entry = std::pair<int, std::int64_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    std::unordered_map<std::int64_t, std::pair<int, std::int64_t>> visited; // cost, parent
+
+    auto heuristic = [&](int chunkX, int chunkY) {
+        return std::max(std::abs(chunkX - goalChunk.x), std::abs(chunkY - goalChunk.y));
+    };
+
+    std::int64_t startKey = chunkKey(startChunk.x, startChunk.y);
+    std::int64_t goalKey = chunkKey(goalChunk.x, goalChunk.y);
+    visited[startKey] = {0, startKey};
+    open.push({heuristic(startChunk.x, startChunk.y), startKey});
+
+    while (!open.empty()) {
+        std::int64_t key = open.top().second;
+        open.pop();
+        if (key == goalKey) break;
+
+        int chunkX = chunkKeyX(key);
+        int chunkY = chunkKeyY(key);
+        const NavChunk* nav = snapshot.getChunk(chunkX, chunkY);
+        if (!nav) continue;
+
+        int cost = visited[key].first + 1;
+        for (int bit = 0; bit < 9; ++bit) {
+            if (!((nav->exits >> bit) & 1)) continue;
+
+            int nextX = chunkX + bit % 3 - 1;
+            int nextY = chunkY + bit / 3 - 1;
+            std::int64_t nextKey = chunkKey(nextX, nextY);
+            auto it = visited.find(nextKey);
+            if (it != visited.end() && it->second.first <= cost) continue;
+
+            visited[nextKey] = {cost, key};
+            open.push({cost + heuristic(nextX, nextY), nextKey});
+        }
+    }
+
+    std::vector<std::int64_t> corridor;
+    if (visited.count(goalKey) == 0) {
+        return corridor;
+    }
+    for (std::int64_t key = goalKey; key != startKey; key = visited[key].second) {
+        corridor.push_back(key);
+    }
+    corridor.push_back(startKey);
+    return corridor;
+}
+
+// Block-level A*, optionally confined to a set of chunks
+std::vector<sf::Vector2i> findCellPath(NavQuery& query, const sf::Vector2i& start, const sf::Vector2i& goal,
+                                       const std::unordered_set<std::int64_t>* allowedChunks) {
+    using Entry = std::pair<float, std::int64_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    std::unordered_map<std::int64_t, std::pair<float, std::int64_t>> visited; // cost, parent
+
+    // Every step moves one column and pays half a block per block of height
+    auto heuristic = [&](int x, int y) {
+        return static_cast<float>(std::abs(x - goal.x)) + 0.5f * std::abs(y - goal.y);
+    };
+
+    std::int64_t startKey = chunkKey(start.x, start.y);
+    std::int64_t goalKey = chunkKey(goal.x, goal.y);
+    visited[startKey] = {0.0f, startKey};
+    open.push({heuristic(start.x, start.y), startKey});
+
+    int expansions = 0;
+    while (!open.empty() && expansions < NavigationGrid::MAX_EXPANSIONS) {
+        auto [priority, key] = open.top();
+        open.pop();
+        if (key == goalKey) break;
+
+        int x = chunkKeyX(key);
+        int y = chunkKeyY(key);
+        float cost = visited[key].first;
+        if (priority > cost + heuristic(x, y) + 0.001f) continue; // Stale entry
+        ++expansions;
+
+        for (int direction : {-1, 1}) {
+            int nextY;
+            if (!query.step(x, y, direction, nextY)) continue;
+
+            int nextX = x + direction;
+            if (allowedChunks &&
+                allowedChunks->count(chunkKey(floorDiv(nextX, Chunk::SIZE), floorDiv(nextY, Chunk::SIZE))) == 0) {
+                continue;
+            }
+
+            float nextCost = cost + 1.0f + 0.5f * std::abs(nextY - y);
+            std::int64_t nextKey = chunkKey(nextX, nextY);
+            auto it = visited.find(nextKey);
+            if (it != visited.end() && it->second.first <= nextCost) continue;
+
+            visited[nextKey] = {nextCost, key};
+            open.push({nextCost + heuristic(nextX, nextY), nextKey});
+        }
+    }
+
+    std::vector<sf::Vector2i> path;
+    if (visited.count(goalKey) == 0) {
+        return path;
+    }
+    for (std::int64_t key = goalKey; key != startKey; key = visited[key].second) {
+        path.emplace_back(chunkKeyX(key), chunkKeyY(key));
+    }
+    path.push_back(start);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+}
+
+const NavChunk* NavSnapshot::getChunk(int chunkX, int chunkY) const {
+    auto it = chunks.find(chunkKey(chunkX, chunkY));
+    return it != chunks.end() ? it->second.get() : nullptr;
+}
+
+NavigationGrid::NavigationGrid() : snapshot(std::make_shared<NavSnapshot>()), builtRevision(0) {}
+
+void NavigationGrid::update(const World& world) {
+    // Most ticks change nothing, no block edited and no chunk loaded or unloaded
+    std::uint64_t worldRevision = world.getRevision();
+    if (worldRevision == builtRevision) {
+        return;
+    }
+
+    std::shared_ptr<const NavSnapshot> current = snapshot;
+    world.getLoadedChunkPositions(loadedChunks);
+
+    // Chunks edited, generated or loaded since the last build
+    changedChunks.clear();
+    for (const auto& position : loadedChunks) {
+        if (world.getLoadedChunk(position.x, position.y)->revision > builtRevision) {
+            changedChunks.insert(chunkKey(position.x, position.y));
+        }
+    }
+
+    // Unloaded chunks change their neighbours as well
+    std::vector<sf::Vector2i> touched;
+    for (const auto& entry : current->chunks) {
+        const sf::Vector2i& position = entry.second->position;
+        if (!world.getLoadedChunk(position.x, position.y)) {
+            changedChunks.insert(entry.first);
+            touched.push_back(position);
+        }
+    }
+
+    auto isCurrent = [&](const NavChunk& nav) {
+        const Chunk* chunk = world.getLoadedChunk(nav.position.x, nav.position.y);
+        const Chunk* above = world.getLoadedChunk(nav.position.x, nav.position.y - 1);
+        const Chunk* below = world.getLoadedChunk(nav.position.x, nav.position.y + 1);
+        return nav.revision == chunk->revision &&
+               nav.revisionAbove == (above ? above->revision : 0) &&
+               nav.revisionBelow == (below ? below->revision : 0);
+    };
+
+    // Reuse every chunk whose blocks, and the blocks around it, are
+    // unchanged. Only chunks next to a change need checking at all.
+    auto next = std::make_shared<NavSnapshot>();
+    next->chunks.reserve(loadedChunks.size());
+    for (const auto& position : loadedChunks) {
+        std::int64_t key = chunkKey(position.x, position.y);
+        bool nearChange = changedChunks.count(key) > 0 ||
+                          changedChunks.count(chunkKey(position.x, position.y - 1)) > 0 ||
+                          changedChunks.count(chunkKey(position.x, position.y + 1)) > 0;
+        auto existing = current->chunks.find(key);
+        if (existing != current->chunks.end() && (!nearChange || isCurrent(*existing->second))) {
+            next->chunks.emplace(key, existing->second);
+            continue;
+        }
+
+        const Chunk* chunk = world.getLoadedChunk(position.x, position.y);
+        const Chunk* above = world.getLoadedChunk(position.x, position.y - 1);
+        const Chunk* below = world.getLoadedChunk(position.x, position.y + 1);
+        next->chunks.emplace(key, buildChunk(position, *chunk, above, below));
+        touched.push_back(position);
+    }
+    builtRevision = worldRevision;
+    if (touched.empty()) {
+        return;
+    }
+
+    // Exits look one move into the neighbouring chunks, so they are
+    // recomputed around every chunk that changed
+    std::unordered_set<std::int64_t> exitsDirty;
+    for (const auto& position : touched) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                exitsDirty.insert(chunkKey(position.x + dx, position.y + dy));
+            }
+        }
+    }
+    for (std::int64_t key : exitsDirty) {
+        auto it = next->chunks.find(key);
+        if (it == next->chunks.end()) continue;
+
+        auto updated = std::make_shared<NavChunk>(*it->second);
+        computeExits(*next, *updated);
+        it->second = std::move(updated);
+    }
+
+    std::atomic_store(&snapshot, std::shared_ptr<const NavSnapshot>(std::move(next)));
+}
+
+std::shared_ptr<const NavSnapshot> NavigationGrid::getSnapshot() const {
+    return std::atomic_load(&snapshot);
+}
+
+std::vector<sf::Vector2i> NavigationGrid::findPath(const NavSnapshot& snapshot,
+                                                   const sf::Vector2i& start, const sf::Vector2i& goal) {
+    NavQuery query(snapshot);
+    sf::Vector2i from = start;
+    sf::Vector2i to = goal;
+    if (!snapToGround(query, from) || !snapToGround(query, to)) {
+        return {};
+    }
+
+    sf::Vector2i startChunk(floorDiv(from.x, Chunk::SIZE), floorDiv(from.y, Chunk::SIZE));
+    sf::Vector2i goalChunk(floorDiv(to.x, Chunk::SIZE), floorDiv(to.y, Chunk::SIZE));
+
+    // No chunk-level route means no block-level route either
+    std::vector<std::int64_t> corridor = findCorridor(snapshot, startChunk, goalChunk);
+    if (corridor.empty()) {
+        return {};
+    }
+
+    // Allow some slack around the corridor for local detours
+    std::unordered_set<std::int64_t> allowed;
+    for (std::int64_t key : corridor) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                allowed.insert(chunkKey(chunkKeyX(key) + dx, chunkKeyY(key) + dy));
+            }
+        }
+    }
+
+    std::vector<sf::Vector2i> path = findCellPath(query, from, to, &allowed);
+    if (path.empty()) {
+        path = findCellPath(query, from, to, nullptr);
+    }
+    return path;
+}
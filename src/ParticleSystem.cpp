@@ -0,0 +1,96 @@
+#include "ParticleSystem.hpp"
+#include <algorithm>
+
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : capacity(capacity), active(0),
+      positionX(capacity), positionY(capacity), velocityX(capacity), velocityY(capacity),
+      life(capacity), colors(capacity), vertices(sf::Quads, capacity * 4),
+      rng(std::random_device{}()) {}
+
+void ParticleSystem::emitBlockDebris(int blockX, int blockY, BlockType type, int count) {
+    if (type == BlockType::Air) return;
+
+    sf::Color tint = Block::getAverageColor(type);
+    std::uniform_real_distribution<float> offset(0.0f, Block::SIZE);
+    std::uniform_real_distribution<float> spread(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> lift(-320.0f, -80.0f);
+    std::uniform_real_distribution<float> shade(0.7f, 1.0f);
+    std::uniform_real_distribution<float> lifetime(0.5f, 1.0f);
+
+    // Particles past capacity are dropped rather than growing the pool
+    std::size_t spawned = std::min(static_cast<std::size_t>(count), capacity - active);
+    for (std::size_t n = 0; n < spawned; ++n) {
+        std::size_t i = active++;
+        positionX[i] = blockX * Block::SIZE + offset(rng);
+        positionY[i] = blockY * Block::SIZE + offset(rng);
+        velocityX[i] = spread(rng);
+        velocityY[i] = lift(rng);
+        life[i] = LIFETIME * lifetime(rng);
+
+        float brightness = shade(rng);
+        colors[i] = sf::Color(static_cast<sf::Uint8>(tint.r * brightness),
+                              static_cast<sf::Uint8>(tint.g * brightness),
+                              static_cast<sf::Uint8>(tint.b * brightness));
+    }
+}
+
+void ParticleSystem::update(float deltaTime) {
+    const std::size_t count = active;
+    float* px = positionX.data();
+    float* py = positionY.data();
+    float* vx = velocityX.data();
+    float* vy = velocityY.data();
+    float* remaining = life.data();
+
+    // Branch-free integration over contiguous arrays
+    for (std::size_t i = 0; i < count; ++i) {
+        vy[i] += GRAVITY * deltaTime;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        remaining[i] -= deltaTime;
+    }
+
+    // Compact by moving the last live particle into each dead slot
+    for (std::size_t i = 0; i < active;) {
+        if (life[i] <= 0.0f) {
+            kill(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void ParticleSystem::render(sf::RenderTarget& target) {
+    if (active == 0) return;
+
+    // The vertex array was sized for the whole pool up front, only the live
+    // prefix is drawn
+    for (std::size_t i = 0; i < active; ++i) {
+        float left = positionX[i];
+        float top = positionY[i];
+        sf::Color color = colors[i];
+        color.a = static_cast<sf::Uint8>(255.0f * std::min(1.0f, life[i] / (LIFETIME * 0.5f)));
+
+        sf::Vertex* quad = &vertices[i * 4];
+        quad[0].position = sf::Vector2f(left, top);
+        quad[1].position = sf::Vector2f(left + PARTICLE_SIZE, top);
+        quad[2].position = sf::Vector2f(left + PARTICLE_SIZE, top + PARTICLE_SIZE);
+        quad[3].position = sf::Vector2f(left, top + PARTICLE_SIZE);
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+    }
+    target.draw(&vertices[0], active * 4, sf::Quads);
+}
+
+std::size_t ParticleSystem::getActiveCount() const {
+    return active;
+}
+
+void ParticleSystem::kill(std::size_t index) {
+    std::size_t last = --active;
+    positionX[index] = positionX[last];
+    positionY[index] = positionY[last];
+    velocityX[index] = velocityX[last];
+    velocityY[index] = velocityY[last];
+    life[index] = life[last];
+    colors[index] = colors[last];
+}
@@ -0,0 +1,19 @@
+#include "Pathfinder.hpp"
+#include "JobSystem.hpp"
+#include <memory>
+
+Pathfinder::Pathfinder(const NavigationGrid& grid)
+    : grid(grid) {}
+
+std::future<std::vector<sf::Vector2i>> Pathfinder::requestPath(const sf::Vector2i& start, const sf::Vector2i& goal) {
+    std::shared_ptr<const NavSnapshot> snapshot = grid.getSnapshot();
+    auto task = std::make_shared<std::packaged_task<std::vector<sf::Vector2i>()>>([snapshot, start, goal]() {
+        return NavigationGrid::findPath(*snapshot, start, goal);
+    });
+    std::future<std::vector<sf::Vector2i>> result = task->get_future();
+
+    // Paths feed actor behaviour, not the visible terrain, so they queue
+    // behind chunk generation
+    JobSystem::instance().submit([task]() { (*task)(); }, JobSystem::Priority::Normal);
+    return result;
+}
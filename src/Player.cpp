@@ -12,24 +12,38 @@ void Player::update(float deltaTime) {
     checkCollisions();
 }
 
-void Player::handleInput() {
+PlayerInput Player::readKeyboard() {
+    PlayerInput input;
+    input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::A);
+    input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+    input.jump = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+    return input;
+}
+
+void Player::applyInput(const PlayerInput& input) {
     velocity.x = 0.0f;
     
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+    if (input.left) {
         velocity.x = -MOVE_SPEED;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+    if (input.right) {
         velocity.x = MOVE_SPEED;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && isOnGround) {
+    if (input.jump && isOnGround) {
         velocity.y = JUMP_FORCE;
         isOnGround = false;
     }
 }
 
-void Player::render(sf::RenderTarget& target) {
-    shape.setPosition(position);
-    target.draw(shape);
+bool Player::getIsOnGround() const {
+    return isOnGround;
+}
+
+void Player::render(sf::RenderTarget& target, const sf::Vector2f& position) const {
+    // Translate at draw time so the render thread never writes to the shape
+    sf::Transform transform;
+    transform.translate(position);
+    target.draw(shape, transform);
 }
 
 void Player::applyPhysics(float deltaTime) {
@@ -101,6 +115,11 @@ const sf::Vector2f& Player::getPosition() const {
     return position;
 }
 
+sf::FloatRect Player::getBounds() const {
+    const sf::Vector2f& size = shape.getSize();
+    return sf::FloatRect(position.x - size.x / 2, position.y - size.y, size.x, size.y);
+}
+
 void Player::setPosition(const sf::Vector2f& pos) {
     position = pos;
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "UILayer.hpp"
+
+void UILayer::addWidget(Widget* widget) {
+    widgets.push_back(widget);
+}
+
+bool UILayer::handleEvent(const sf::Event& event) {
+    // Widgets added last are drawn on top, so they see events first
+    for (auto it = widgets.rbegin(); it != widgets.rend(); ++it) {
+        if ((*it)->handleEvent(event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t UILayer::render(sf::RenderTarget& target) {
+    for (Widget* widget : widgets) {
+        widget->render(target);
+    }
+    return widgets.size();
+}
@@ -0,0 +1,36 @@
+#include "Widget.hpp"
+#include <iostream>
+
+Widget::Widget(unsigned width, unsigned height)
+    : size(static_cast<float>(width), static_cast<float>(height)), dirty(true) {
+    if (!canvas.create(width, height)) {
+        std::cerr << "Failed to create widget canvas" << std::endl;
+    }
+    sprite.setTexture(canvas.getTexture(), true);
+}
+
+bool Widget::handleEvent(const sf::Event&) {
+    return false;
+}
+
+void Widget::render(sf::RenderTarget& target) {
+    if (dirty) {
+        canvas.clear(sf::Color::Transparent);
+        redraw(canvas);
+        canvas.display();
+        dirty = false;
+    }
+    target.draw(sprite);
+}
+
+void Widget::setPosition(const sf::Vector2f& position) {
+    sprite.setPosition(position);
+}
+
+sf::Vector2f Widget::getSize() const {
+    return size;
+}
+
+void Widget::invalidate() {
+    dirty = true;
+}
@@ -1,125 +1,101 @@
 #include "World.hpp"
+#include "JobSystem.hpp"
+#include "Metrics.hpp"
+#include "PerlinNoise.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <random>
 
-// Simple 2D Perlin noise implementation
-class PerlinNoise {
-private:
-    std::vector<int> p;
-    
-    static double fade(double t) {
-        return t * t * t * (t * (t * 6 - 15) + 10);
-    }
-    
-    static double lerp(double t, double a, double b) {
-        return a + t * (b - a);
-    }
-    
-    static double grad(int hash, double x, double y) {
-        int h = hash & 15;
-        double u = h < 8 ? x : y;
-        double v = h < 4 ? y : h == 12 || h == 14 ? x : 0;
-        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
-    }
-    
-public:
-    PerlinNoise() {
-        p.resize(512);
-        for(int i = 0; i < 256; ++i) p[i] = i;
-        
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::shuffle(p.begin(), p.begin() + 256, gen);
-        
-        for(int i = 0; i < 256; ++i) p[256 + i] = p[i];
-    }
-    
-    double noise(double x, double y) {
-        int X = static_cast<int>(std::floor(x)) & 255;
-        int Y = static_cast<int>(std::floor(y)) & 255;
-        
-        x -= std::floor(x);
-        y -= std::floor(y);
-        
-        double u = fade(x);
-        double v = fade(y);
-        
-        int A  = p[X] + Y;
-        int AA = p[A];
-        int AB = p[A + 1];
-        int B  = p[X + 1] + Y;
-        int BA = p[B];
-        int BB = p[B + 1];
-        
-        return lerp(v, lerp(u, grad(p[AA], x, y),
-                              grad(p[BA], x - 1, y)),
-                      lerp(u, grad(p[AB], x, y - 1),
-                              grad(p[BB], x - 1, y - 1)));
-    }
-};
-
 static PerlinNoise perlin;
 
-World::World() {
+namespace {
+MetricsRegistry& registry = MetricsRegistry::instance();
+Counter& chunksGenerated = registry.addCounter("blockworld_chunks_generated_total", "Chunks generated from terrain noise");
+Counter& chunksLoaded = registry.addCounter("blockworld_chunks_loaded_total", "Cold chunks inflated back into the hot tier");
+Counter& chunksCompressed = registry.addCounter("blockworld_chunks_compressed_total", "Hot chunks compressed into the cold tier");
+Counter& chunksEvicted = registry.addCounter("blockworld_chunks_evicted_total", "Cold chunks dropped from memory");
+Counter& setBlockCalls = registry.addCounter("blockworld_set_block_total", "Blocks changed through setBlock");
+Histogram& generationLatency = registry.addHistogram("blockworld_chunk_generation_seconds", "Time to generate one chunk",
+                                                     MetricsRegistry::latencyBuckets());
+}
+
+World::World()
+    : chunks(&chunkNodes), coldChunks(&chunkNodes), seed(std::random_device{}()),
+      coldChunkBytes(0), lastRevision(0), generatedChunkCount(0), editedChunkCount(0) {
     perlin = PerlinNoise();
 }
 
+World::~World() {
+    for (auto& entry : chunks) {
+        chunkPool.release(entry.second);
+    }
+}
+
 void World::update(float deltaTime) {
     // Update active chunks if needed
 }
 
-void World::render(sf::RenderTarget& target, const sf::Vector2f& cameraPosition) {
-    // Calculate visible chunk range based on camera position
-    int startChunkX = static_cast<int>(std::floor((cameraPosition.x - target.getView().getSize().x/2) / (Chunk::SIZE * Block::SIZE))) - 1;
-    int endChunkX = static_cast<int>(std::ceil((cameraPosition.x + target.getView().getSize().x/2) / (Chunk::SIZE * Block::SIZE))) + 1;
-    int startChunkY = static_cast<int>(std::floor((cameraPosition.y - target.getView().getSize().y/2) / (Chunk::SIZE * Block::SIZE))) - 1;
-    int endChunkY = static_cast<int>(std::ceil((cameraPosition.y + target.getView().getSize().y/2) / (Chunk::SIZE * Block::SIZE))) + 1;
-    
-    // Generate and render visible chunks
-    for (int cx = startChunkX; cx <= endChunkX; ++cx) {
-        for (int cy = startChunkY; cy <= endChunkY; ++cy) {
-            if (!chunks[cx][cy].isGenerated) {
-                generateChunk(cx, cy);
-            }
-            
-            // Render chunk
-            for (int x = 0; x < Chunk::SIZE; ++x) {
-                for (int y = 0; y < Chunk::SIZE; ++y) {
-                    chunks[cx][cy].blocks[x][y].render(target, 
-                        cx * Chunk::SIZE + x, 
-                        cy * Chunk::SIZE + y);
+void World::stream(const sf::Vector2f& center, const sf::Vector2f& viewSize) {
+    streamViewers(&center, 1, viewSize);
+}
+
+void World::stream(const std::vector<sf::Vector2f>& centers, const sf::Vector2f& viewSize) {
+    streamViewers(centers.data(), centers.size(), viewSize);
+}
+
+void World::streamViewers(const sf::Vector2f* centers, std::size_t count, const sf::Vector2f& viewSize) {
+    viewRanges.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        const sf::Vector2f& center = centers[i];
+
+        // Calculate visible chunk range based on camera position
+        int startChunkX = static_cast<int>(std::floor((center.x - viewSize.x/2) / (Chunk::SIZE * Block::SIZE))) - 1;
+        int endChunkX = static_cast<int>(std::ceil((center.x + viewSize.x/2) / (Chunk::SIZE * Block::SIZE))) + 1;
+        int startChunkY = static_cast<int>(std::floor((center.y - viewSize.y/2) / (Chunk::SIZE * Block::SIZE))) - 1;
+        int endChunkY = static_cast<int>(std::ceil((center.y + viewSize.y/2) / (Chunk::SIZE * Block::SIZE))) + 1;
+        
+        // Queue the visible chunks that are not resident yet
+        for (int cx = startChunkX; cx <= endChunkX; ++cx) {
+            for (int cy = startChunkY; cy <= endChunkY; ++cy) {
+                if (!findChunk(cx, cy)) {
+                    Chunk* chunk = chunkPool.acquire();
+                    chunks.emplace(chunkKey(cx, cy), chunk);
+                    pendingChunks.push_back({{cx, cy}, chunk});
                 }
             }
         }
+
+        viewRanges.push_back({startChunkX, endChunkX, startChunkY, endChunkY});
     }
+
+    generatePendingChunks();
+    updateResidency();
 }
 
 Block* World::getBlock(int x, int y) {
-    int chunkX = std::floor(static_cast<float>(x) / Chunk::SIZE);
-    int chunkY = std::floor(static_cast<float>(y) / Chunk::SIZE);
-    int localX = x - chunkX * Chunk::SIZE;
-    int localY = y - chunkY * Chunk::SIZE;
+    int chunkX = floorDiv(x, Chunk::SIZE);
+    int chunkY = floorDiv(y, Chunk::SIZE);
     
-    if (localX < 0) localX += Chunk::SIZE;
-    if (localY < 0) localY += Chunk::SIZE;
-    
-    if (chunks.count(chunkX) > 0 && chunks[chunkX].count(chunkY) > 0) {
-        return &chunks[chunkX][chunkY].blocks[localX][localY];
+    if (Chunk* chunk = findChunk(chunkX, chunkY)) {
+        return &chunk->blocks[x - chunkX * Chunk::SIZE][y - chunkY * Chunk::SIZE];
     }
     return nullptr;
 }
 
 void World::setBlock(int x, int y, BlockType type) {
-    int chunkX = std::floor(static_cast<float>(x) / Chunk::SIZE);
-    int chunkY = std::floor(static_cast<float>(y) / Chunk::SIZE);
-    int localX = x - chunkX * Chunk::SIZE;
-    int localY = y - chunkY * Chunk::SIZE;
-    
-    if (localX < 0) localX += Chunk::SIZE;
-    if (localY < 0) localY += Chunk::SIZE;
+    int chunkX = floorDiv(x, Chunk::SIZE);
+    int chunkY = floorDiv(y, Chunk::SIZE);
     
-    if (chunks.count(chunkX) > 0 && chunks[chunkX].count(chunkY) > 0) {
-        chunks[chunkX][chunkY].blocks[localX][localY] = Block(type);
+    if (Chunk* chunk = findChunk(chunkX, chunkY)) {
+        chunk->blocks[x - chunkX * Chunk::SIZE][y - chunkY * Chunk::SIZE] = Block(type);
+        chunk->isModified = true;
+        chunk->revision = ++lastRevision;
+        setBlockCalls.increment();
+        if (!chunk->isDirty) {
+            ++editedChunkCount;
+        }
+        markChanged(*chunk, chunkX, chunkY);
     }
 }
 
@@ -127,72 +103,258 @@ bool World::isPositionSolid(float x, float y) const {
     int blockX = static_cast<int>(std::floor(x / Block::SIZE));
     int blockY = static_cast<int>(std::floor(y / Block::SIZE));
     
-    int chunkX = std::floor(static_cast<float>(blockX) / Chunk::SIZE);
-    int chunkY = std::floor(static_cast<float>(blockY) / Chunk::SIZE);
+    int chunkX = floorDiv(blockX, Chunk::SIZE);
+    int chunkY = floorDiv(blockY, Chunk::SIZE);
+    
+    int localX = blockX - chunkX * Chunk::SIZE;
+    int localY = blockY - chunkY * Chunk::SIZE;
+    
+    auto hot = chunks.find(chunkKey(chunkX, chunkY));
+    if (hot != chunks.end()) {
+        return hot->second->blocks[localX][localY].isSolid();
+    }
     
-    if (chunks.count(chunkX) > 0 && chunks.at(chunkX).count(chunkY) > 0) {
-        int localX = blockX - chunkX * Chunk::SIZE;
-        int localY = blockY - chunkY * Chunk::SIZE;
-        if (localX < 0) localX += Chunk::SIZE;
-        if (localY < 0) localY += Chunk::SIZE;
-        return chunks.at(chunkX).at(chunkY).blocks[localX][localY].isSolid();
+    // Cold chunks can be read without inflating them
+    auto cold = coldChunks.find(chunkKey(chunkX, chunkY));
+    if (cold != coldChunks.end()) {
+        return Block(cold->second.get(localX, localY)).isSolid();
     }
     return false;
 }
 
-void World::generateChunk(int chunkX, int chunkY) {
-    chunks[chunkX][chunkY].blocks.resize(Chunk::SIZE, std::vector<Block>(Chunk::SIZE));
-    generateTerrain(chunks[chunkX][chunkY], chunkX, chunkY);
-    generateStructures(chunks[chunkX][chunkY], chunkX, chunkY);
-    chunks[chunkX][chunkY].isGenerated = true;
+const Chunk* World::getLoadedChunk(int chunkX, int chunkY) const {
+    auto it = chunks.find(chunkKey(chunkX, chunkY));
+    return it != chunks.end() ? it->second : nullptr;
 }
 
-void World::generateTerrain(Chunk& chunk, int chunkX, int chunkY) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+void World::getLoadedChunkPositions(std::vector<sf::Vector2i>& positions) const {
+    positions.clear();
+    for (const auto& entry : chunks) {
+        positions.emplace_back(chunkKeyX(entry.first), chunkKeyY(entry.first));
+    }
+}
+
+void World::takeChunkChanges(std::vector<sf::Vector2i>& changed, std::vector<sf::Vector2i>& removed) {
+    for (const auto& position : changedChunks) {
+        auto it = chunks.find(chunkKey(position.x, position.y));
+        if (it != chunks.end()) {
+            it->second->isDirty = false;
+        }
+    }
+
+    changed.clear();
+    removed.clear();
+    changed.swap(changedChunks);
+    removed.swap(removedChunks);
+}
+
+const ChunkPool& World::getChunkPool() const {
+    return chunkPool;
+}
+
+std::size_t World::getHotChunkCount() const {
+    return chunks.size();
+}
+
+std::size_t World::getColdChunkCount() const {
+    return coldChunks.size();
+}
+
+std::size_t World::getResidentChunkBytes() const {
+    return chunks.size() * sizeof(Chunk) + coldChunkBytes;
+}
+
+std::uint64_t World::getGeneratedChunkCount() const {
+    return generatedChunkCount;
+}
+
+std::uint64_t World::getEditedChunkCount() const {
+    return editedChunkCount;
+}
+
+std::uint64_t World::getRevision() const {
+    return lastRevision;
+}
+
+Chunk* World::findChunk(int chunkX, int chunkY) {
+    std::int64_t key = chunkKey(chunkX, chunkY);
+    auto hot = chunks.find(key);
+    if (hot != chunks.end()) {
+        return hot->second;
+    }
+
+    // Inflate a cold chunk back into the hot tier on access
+    auto cold = coldChunks.find(key);
+    if (cold == coldChunks.end()) {
+        return nullptr;
+    }
+
+    Chunk* chunk = chunkPool.acquire();
+    cold->second.decompress(*chunk);
+    chunk->revision = ++lastRevision;
+    coldChunkBytes -= cold->second.getMemoryUsage();
+    coldChunks.erase(cold);
+    chunksLoaded.increment();
+    chunks.emplace(key, chunk);
+    markChanged(*chunk, chunkX, chunkY);
+    return chunk;
+}
+
+void World::generatePendingChunks() {
+    if (pendingChunks.empty()) {
+        return;
+    }
+
+    // Climate regions are created on first use, so build them here. The
+    // workers then only use the read-only lookup.
+    for (const auto& pending : pendingChunks) {
+        biomeMap.getColumn(pending.first.x * Chunk::SIZE);
+    }
+
+    // Generation only touches the chunk itself, every chunk is its own job
+    JobSystem::instance().parallelFor(pendingChunks.size(), 1, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            generateChunk(*pendingChunks[i].second, pendingChunks[i].first.x, pendingChunks[i].first.y);
+            generationLatency.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+    }, JobSystem::Priority::High);
+
+    for (const auto& pending : pendingChunks) {
+        pending.second->revision = ++lastRevision;
+        chunksGenerated.increment();
+        ++generatedChunkCount;
+        markChanged(*pending.second, pending.first.x, pending.first.y);
+    }
+    pendingChunks.clear();
+}
+
+void World::markChanged(Chunk& chunk, int chunkX, int chunkY) {
+    if (!chunk.isDirty) {
+        chunk.isDirty = true;
+        changedChunks.emplace_back(chunkX, chunkY);
+    }
+}
+
+void World::updateResidency() {
+    // Only rebalance the tiers when a viewer crosses into new chunks
+    if (viewRanges == residencyRanges) {
+        return;
+    }
+    residencyRanges = viewRanges;
+
+    // A chunk stays in a tier while it is close enough to any viewer
+    auto inRange = [this](std::int64_t key, int distance) {
+        int chunkX = chunkKeyX(key);
+        int chunkY = chunkKeyY(key);
+        for (const auto& range : residencyRanges) {
+            if (chunkX >= range[0] - distance && chunkX <= range[1] + distance &&
+                chunkY >= range[2] - distance && chunkY <= range[3] + distance) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Hot chunks that left the view are compressed into the cold tier
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        if (inRange(it->first, HOT_DISTANCE)) {
+            ++it;
+            continue;
+        }
+        auto cold = coldChunks.try_emplace(it->first, *it->second, &chunkNodes).first;
+        coldChunkBytes += cold->second.getMemoryUsage();
+        chunksCompressed.increment();
+        removedChunks.emplace_back(chunkKeyX(it->first), chunkKeyY(it->first));
+        chunkPool.release(it->second);
+        it = chunks.erase(it);
+        ++lastRevision; // Leaving the hot tier counts as a change for revision watchers
+    }
+
+    // Edited chunks stay resident since there is nowhere to save them yet
+    for (auto it = coldChunks.begin(); it != coldChunks.end();) {
+        if (inRange(it->first, COLD_DISTANCE) || it->second.isModified()) {
+            ++it;
+        } else {
+            coldChunkBytes -= it->second.getMemoryUsage();
+            it = coldChunks.erase(it);
+            chunksEvicted.increment();
+        }
+    }
+
+    // Climate regions are only kept while a resident chunk lies in them
+    usedRegions.clear();
+    for (const auto& entry : chunks) {
+        usedRegions.push_back(BiomeMap::getRegionIndex(chunkKeyX(entry.first) * Chunk::SIZE));
+    }
+    for (const auto& entry : coldChunks) {
+        usedRegions.push_back(BiomeMap::getRegionIndex(chunkKeyX(entry.first) * Chunk::SIZE));
+    }
+    std::sort(usedRegions.begin(), usedRegions.end());
+    usedRegions.erase(std::unique(usedRegions.begin(), usedRegions.end()), usedRegions.end());
+    biomeMap.retainRegions(usedRegions);
+}
+
+void World::generateChunk(Chunk& chunk, int chunkX, int chunkY) const {
+    generateTerrain(chunk, chunkX, chunkY);
+    generateStructures(chunk, chunkX, chunkY);
+    chunk.isGenerated = true;
+}
+
+std::uint32_t World::chunkSeed(int chunkX, int chunkY) const {
+    // splitmix64 over the world seed and chunk position, std::seed_seq
+    // would allocate for every chunk
+    std::uint64_t z = (static_cast<std::uint64_t>(seed) << 32) ^
+                      (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX)) * 0x9E3779B97F4A7C15ull) ^
+                      static_cast<std::uint32_t>(chunkY);
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<std::uint32_t>(z ^ (z >> 31));
+}
+
+void World::generateTerrain(Chunk& chunk, int chunkX, int chunkY) const {
+    // Seed per chunk so an evicted chunk regenerates identically
+    std::mt19937 gen(chunkSeed(chunkX, chunkY));
     std::uniform_real_distribution<> diamond_dist(0.0, 1.0);
     std::uniform_real_distribution<> tree_dist(0.0, 1.0);
-    std::vector<std::pair<int, int>> treePlacements;
+
+    // At most one tree per column, so the placements fit on the stack
+    std::array<std::pair<int, int>, Chunk::SIZE> treePlacements;
+    std::size_t treeCount = 0;
 
     for (int x = 0; x < Chunk::SIZE; ++x) {
-        // Generate height using multiple noise functions for more interesting terrain
         double worldX = (chunkX * Chunk::SIZE + x) * TERRAIN_SCALE;
-        double baseHeight = Chunk::SIZE - 10.0;
-        
-        // Add multiple noise components at different scales for more natural terrain
-        double noiseScale1 = 0.5; // Large-scale terrain features
-        double noiseScale2 = 2.0; // Medium details
-        double noiseScale3 = 5.0; // Small details
-        
-        double heightNoise = perlin.noise(worldX * noiseScale1, 0) * 6.0 +
-                             perlin.noise(worldX * noiseScale2, 0) * 3.0 +
-                             perlin.noise(worldX * noiseScale3, 0) * 1.0;
-                             
-        // Add hills with sine waves of different periods
-        double sineComponent = sin(worldX * 0.2) * 3.0 +
-                               sin(worldX * 0.05) * 5.0;
-                               
-        int surfaceHeight = static_cast<int>(baseHeight + heightNoise + sineComponent);
-
-        // Track terrain surface for tree placement
-        int terrainSurfaceY = surfaceHeight + 1;
+
+        // Surface height and biome come from the cached region climate
+        const TerrainColumn& column = biomeMap.getCachedColumn(chunkX * Chunk::SIZE + x);
+        int surfaceHeight = column.surfaceHeight;
+        bool sandy = column.biome == Biome::Desert || column.biome == Biome::Ocean ||
+                     surfaceHeight + 1 >= WATER_LEVEL;
+        double treeChance = column.biome == Biome::Forest ? 0.2 :
+                            column.biome == Biome::Plains ? 0.05 : 0.0;
         
         for (int y = 0; y < Chunk::SIZE; ++y) {
             int worldY = chunkY * Chunk::SIZE + y;
             
-            // Default to air only above the surface height
+            // Default to air only above the surface height, oceans and
+            // lakes fill up to the water level
             if (worldY <= surfaceHeight) {
-                chunk.blocks[x][y] = Block(BlockType::Air);
+                chunk.blocks[x][y] = Block(worldY >= WATER_LEVEL ? BlockType::Water : BlockType::Air);
             }
             else if (worldY == surfaceHeight + 1) {
-                // Surface layer - grass
-                chunk.blocks[x][y] = Block(BlockType::Grass);
+                // Surface layer - grass, or sand in deserts and under water
+                chunk.blocks[x][y] = Block(sandy ? BlockType::Sand : BlockType::Grass);
                 
                 // Consider placing a tree on this grass block
-                if (tree_dist(gen) < 0.05) {  // 5% chance for a tree
-                    treePlacements.push_back(std::make_pair(x, y));
+                if (!sandy && tree_dist(gen) < treeChance) {
+                    treePlacements[treeCount++] = std::make_pair(x, y);
                 }
             }
+            // Deserts have a thicker sand layer
+            else if (column.biome == Biome::Desert && worldY <= surfaceHeight + 4) {
+                chunk.blocks[x][y] = Block(BlockType::Sand);
+            }
             // Dirt layer (3-5 blocks with variable depth)
             else if (worldY <= surfaceHeight + 3 + static_cast<int>(perlin.noise(worldX * 5.0, worldY * 5.0) * 2.0)) {
                 chunk.blocks[x][y] = Block(BlockType::Dirt);
@@ -265,14 +427,14 @@ void World::generateTerrain(Chunk& chunk, int chunkX, int chunkY) {
     }
     
     // Generate trees after terrain is complete
-    for (const auto& treePos : treePlacements) {
-        generateTree(chunk, treePos.first, treePos.second);
+    for (std::size_t i = 0; i < treeCount; ++i) {
+        generateTree(chunk, treePlacements[i].first, treePlacements[i].second, gen);
     }
 }
 
-void World::generateTree(Chunk& chunk, int x, int y) {
+void World::generateTree(Chunk& chunk, int x, int y, std::mt19937& gen) const {
     // Define tree characteristics
-    const int trunkHeight = 4 + rand() % 3; // 4-6 blocks tall
+    const int trunkHeight = 4 + static_cast<int>(gen() % 3); // 4-6 blocks tall
     const int leavesRadius = 2;
     
     // Generate trunk
@@ -307,6 +469,6 @@ void World::generateTree(Chunk& chunk, int x, int y) {
     }
 }
 
-void World::generateStructures(Chunk& chunk, int chunkX, int chunkY) {
+void World::generateStructures(Chunk& chunk, int chunkX, int chunkY) const {
     // Empty - no structures in this simplified version
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "WorldRenderer.hpp"
+#include <cmath>
+
+void WorldRenderer::applyUpdates(const std::vector<ChunkUpdate>& updates) {
+    for (const auto& update : updates) {
+        std::int64_t key = chunkKey(update.position.x, update.position.y);
+        if (update.removed) {
+            chunks.erase(key);
+        } else {
+            chunks[key] = update.blocks;
+        }
+    }
+}
+
+BlockType WorldRenderer::getBlockType(int x, int y) const {
+    int chunkX = floorDiv(x, Chunk::SIZE);
+    int chunkY = floorDiv(y, Chunk::SIZE);
+
+    auto it = chunks.find(chunkKey(chunkX, chunkY));
+    if (it == chunks.end()) {
+        return BlockType::Air;
+    }
+    return it->second[(x - chunkX * Chunk::SIZE) * Chunk::SIZE + (y - chunkY * Chunk::SIZE)];
+}
+
+std::size_t WorldRenderer::render(sf::RenderTarget& target, const sf::Vector2f& cameraPosition) const {
+    // Calculate visible chunk range based on camera position
+    int startChunkX = static_cast<int>(std::floor((cameraPosition.x - target.getView().getSize().x/2) / (Chunk::SIZE * Block::SIZE))) - 1;
+    int endChunkX = static_cast<int>(std::ceil((cameraPosition.x + target.getView().getSize().x/2) / (Chunk::SIZE * Block::SIZE))) + 1;
+    int startChunkY = static_cast<int>(std::floor((cameraPosition.y - target.getView().getSize().y/2) / (Chunk::SIZE * Block::SIZE))) - 1;
+    int endChunkY = static_cast<int>(std::ceil((cameraPosition.y + target.getView().getSize().y/2) / (Chunk::SIZE * Block::SIZE))) + 1;
+    std::size_t draws = 0;
+
+    for (int cx = startChunkX; cx <= endChunkX; ++cx) {
+        for (int cy = startChunkY; cy <= endChunkY; ++cy) {
+            auto it = chunks.find(chunkKey(cx, cy));
+            if (it == chunks.end()) {
+                continue; // Not generated yet
+            }
+
+            // Render chunk
+            for (int x = 0; x < Chunk::SIZE; ++x) {
+                for (int y = 0; y < Chunk::SIZE; ++y) {
+                    BlockType type = it->second[x * Chunk::SIZE + y];
+                    if (type == BlockType::Air) continue;
+
+                    Block(type).render(target,
+                        cx * Chunk::SIZE + x,
+                        cy * Chunk::SIZE + y);
+                    ++draws;
+                }
+            }
+        }
+    }
+    return draws;
+}
@@ -0,0 +1,249 @@
+// Headless load generator. Spawns N scripted bots that walk, jump and dig
+// through a World using the same physics, generation and residency paths as
+// the game, and reports how tick time and memory scale with N. Bots also
+// run through the entity broadphase every tick to find the ones in contact.
+// With a cluster size above one, bots spawn shoulder to shoulder in groups
+// so the broadphase has contacts to find.
+//
+// Usage: BlockworldLoadTest [maxBots] [ticksPerRun] [clusterSize]
+#include "EntityGrid.hpp"
+#include "World.hpp"
+#include "Player.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <vector>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr float TICK_DURATION = 1.0f / 60.0f; // Same fixed tick as Game
+constexpr float VIEW_WIDTH = 1280.0f;          // Same view as the game window
+constexpr float VIEW_HEIGHT = 720.0f;
+constexpr int SPAWN_SPACING = 96;              // Blocks between neighbouring bots or clusters
+static_assert(SPAWN_SPACING % Chunk::SIZE == 0, "Clusters spawn on a chunk edge");
+
+struct Bot {
+    std::unique_ptr<Player> player;
+    PlayerInput input;
+    float decisionTimer = 0.0f;
+    float digTimer = 0.0f;
+    float lastX = 0.0f;
+    int heading = 1; // Direction the bot explores in
+    std::mt19937 rng;
+};
+
+struct RunResult {
+    std::vector<double> tickMillis;
+    std::uint64_t totalGenerated = 0;
+    std::uint64_t peakGenerated = 0;
+    std::uint64_t totalEdited = 0;
+    std::size_t totalContacts = 0;
+    std::size_t hotChunks = 0;
+    std::size_t coldChunks = 0;
+    std::size_t residentBytes = 0;
+    std::size_t poolBytes = 0;
+    long rssDeltaKB = 0;
+};
+
+long residentSetKB() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    long size = 0, resident = 0;
+    if (statm >> size >> resident) {
+        return resident * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+#endif
+    return 0;
+}
+
+// Place a bot one block above the first solid block in its column, shifted
+// sideways by offsetX pixels. The column must already have been streamed in.
+void spawnBot(Bot& bot, World& world, int blockX, float offsetX) {
+    int spawnY = 0;
+    for (int y = -48; y < 64; ++y) {
+        Block* block = world.getBlock(blockX, y);
+        if (block && block->isSolid()) {
+            spawnY = y - 1;
+            break;
+        }
+    }
+    bot.player->setPosition(sf::Vector2f(blockX * Block::SIZE + offsetX, spawnY * Block::SIZE));
+    bot.lastX = bot.player->getPosition().x;
+}
+
+void think(Bot& bot, World& world, float deltaTime) {
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    const sf::Vector2f& position = bot.player->getPosition();
+
+    // Mostly keep exploring outwards, sometimes turn around or stand still
+    bot.decisionTimer -= deltaTime;
+    if (bot.decisionTimer <= 0.0f) {
+        float roll = chance(bot.rng);
+        int direction = roll < 0.7f ? bot.heading : roll < 0.9f ? -bot.heading : 0;
+        bot.input.left = direction < 0;
+        bot.input.right = direction > 0;
+        bot.decisionTimer = 1.0f + chance(bot.rng) * 3.0f;
+    }
+
+    // Jump when walking into a wall, and now and then for no reason
+    bool moving = bot.input.left || bot.input.right;
+    bool stuck = moving && std::abs(position.x - bot.lastX) < 0.01f;
+    bot.input.jump = stuck || chance(bot.rng) < 0.01f;
+    bot.lastX = position.x;
+
+    // Dig out the block ahead, or the one underfoot
+    bot.digTimer -= deltaTime;
+    if (bot.digTimer <= 0.0f) {
+        int blockX = static_cast<int>(std::floor(position.x / Block::SIZE));
+        int blockY = static_cast<int>(std::floor(position.y / Block::SIZE));
+        if (chance(bot.rng) < 0.5f) {
+            int facing = bot.input.left ? -1 : 1;
+            world.setBlock(blockX + facing, blockY - 1, BlockType::Air);
+        } else {
+            world.setBlock(blockX, blockY, BlockType::Air);
+        }
+        bot.digTimer = 0.25f + chance(bot.rng) * 0.75f;
+    }
+
+    bot.player->applyInput(bot.input);
+}
+
+RunResult runLoad(int botCount, int ticks, int clusterSize) {
+    RunResult result;
+    long rssBefore = residentSetKB();
+
+    World world;
+    std::vector<Bot> bots(botCount);
+    std::vector<sf::Vector2f> positions(botCount);
+    std::vector<sf::Vector2i> changed;
+    std::vector<sf::Vector2i> removed;
+    EntityGrid entities;
+    std::vector<std::pair<EntityGrid::EntityId, EntityGrid::EntityId>> contacts;
+    sf::Vector2f viewSize(VIEW_WIDTH, VIEW_HEIGHT);
+
+    // Spread the bots, or clusters of them, out on both sides of the origin.
+    // Lone bots stand in the middle of their block. Clusters are centered on
+    // a chunk edge, so each straddles two broadphase cells and its members
+    // start out overlapping.
+    std::vector<int> spawnColumns(botCount);
+    std::vector<float> spawnOffsets(botCount);
+    for (int i = 0; i < botCount; ++i) {
+        int cluster = i / clusterSize;
+        int member = i % clusterSize;
+        bots[i].heading = cluster % 2 == 0 ? 1 : -1;
+        spawnColumns[i] = bots[i].heading * (cluster / 2 + cluster % 2) * SPAWN_SPACING;
+        spawnOffsets[i] = clusterSize > 1 ? (member - (clusterSize - 1) / 2.0f) * Block::SIZE / 2
+                                          : Block::SIZE / 2.0f;
+        positions[i] = sf::Vector2f(spawnColumns[i] * Block::SIZE, 0.0f);
+    }
+
+    // Stream all spawn areas together so no bot's area is evicted by another's
+    world.stream(positions, viewSize);
+    for (int i = 0; i < botCount; ++i) {
+        Bot& bot = bots[i];
+        bot.player = std::make_unique<Player>(world);
+        bot.rng.seed(static_cast<std::uint32_t>(i) * 7919u + 1u);
+        spawnBot(bot, world, spawnColumns[i], spawnOffsets[i]);
+    }
+    world.takeChunkChanges(changed, removed);
+    std::uint64_t generatedBefore = world.getGeneratedChunkCount();
+    std::uint64_t editedBefore = world.getEditedChunkCount();
+
+    result.tickMillis.reserve(ticks);
+    for (int tick = 0; tick < ticks; ++tick) {
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < botCount; ++i) {
+            think(bots[i], world, TICK_DURATION);
+            bots[i].player->update(TICK_DURATION);
+            positions[i] = bots[i].player->getPosition();
+        }
+        world.stream(positions, viewSize);
+
+        // Rebuild the broadphase and find the bots touching each other
+        entities.clear();
+        for (int i = 0; i < botCount; ++i) {
+            entities.insert(static_cast<EntityGrid::EntityId>(i), bots[i].player->getBounds());
+        }
+        entities.findOverlappingPairs(contacts);
+
+        // Drain the changes like the game does when publishing a snapshot
+        world.takeChunkChanges(changed, removed);
+
+        auto end = std::chrono::steady_clock::now();
+        result.tickMillis.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        // Generated and edited chunks both show up in changed, count them apart
+        std::uint64_t generated = world.getGeneratedChunkCount() - generatedBefore;
+        generatedBefore = world.getGeneratedChunkCount();
+        result.totalGenerated += generated;
+        result.peakGenerated = std::max(result.peakGenerated, generated);
+        result.totalEdited += world.getEditedChunkCount() - editedBefore;
+        editedBefore = world.getEditedChunkCount();
+        result.totalContacts += contacts.size();
+    }
+
+    result.hotChunks = world.getHotChunkCount();
+    result.coldChunks = world.getColdChunkCount();
+    result.residentBytes = world.getResidentChunkBytes();
+    result.poolBytes = world.getChunkPool().getCapacity() * sizeof(Chunk);
+    result.rssDeltaKB = residentSetKB() - rssBefore;
+    return result;
+}
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0.0;
+    std::size_t index = static_cast<std::size_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int maxBots = argc > 1 ? std::max(1, std::atoi(argv[1])) : 64;
+    int ticks = argc > 2 ? std::max(1, std::atoi(argv[2])) : 600;
+    int clusterSize = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1;
+
+    std::printf("%6s %8s %8s %8s %8s %8s %8s %8s %10s %6s %6s %12s %10s %10s\n",
+                "bots", "p50 ms", "p95 ms", "p99 ms", "max ms", "gen/t", "peak gen", "edited/t", "contacts/t",
+                "hot", "cold", "resident KB", "pool KB", "rss +KB");
+
+    // Powers of two below the maximum, then the maximum itself
+    std::vector<int> sizes;
+    for (int bots = 1; bots < maxBots; bots *= 2) {
+        sizes.push_back(bots);
+    }
+    sizes.push_back(maxBots);
+
+    for (int bots : sizes) {
+        RunResult result = runLoad(bots, ticks, clusterSize);
+        double maxMillis = *std::max_element(result.tickMillis.begin(), result.tickMillis.end());
+
+        std::printf("%6d %8.3f %8.3f %8.3f %8.3f %8.2f %8llu %8.2f %10.2f %6zu %6zu %12zu %10zu %10ld\n",
+                    bots,
+                    percentile(result.tickMillis, 0.50),
+                    percentile(result.tickMillis, 0.95),
+                    percentile(result.tickMillis, 0.99),
+                    maxMillis,
+                    static_cast<double>(result.totalGenerated) / ticks,
+                    static_cast<unsigned long long>(result.peakGenerated),
+                    static_cast<double>(result.totalEdited) / ticks,
+                    static_cast<double>(result.totalContacts) / ticks,
+                    result.hotChunks,
+                    result.coldChunks,
+                    result.residentBytes / 1024,
+                    result.poolBytes / 1024,
+                    result.rssDeltaKB);
+        std::fflush(stdout);
+    }
+    return 0;
+}